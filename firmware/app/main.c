@@ -9,21 +9,32 @@
 
 #include "system_init.h"
 #include "gpio_hal.h"
+#include "core_mailbox.h"     /* Lock-free inter-core message rings */
 
 #include "pico/stdlib.h"
 #include "pico/cyw43_arch.h"  /* Pico W onboard LED is on CYW43 */
 
 #ifndef BUILD_PRODUCTION
 #include "ai_log.h"           /* BB2: Tokenized logging */
+#include "log_persist.h"      /* BB2: Optional flash log ring */
+#include "mem_pool.h"         /* Fixed-block pools (cJSON, buffers) */
 #include "fs_manager.h"       /* BB4: Persistent configuration */
+#include "asset_store.h"      /* BB4: Zero-copy XIP asset store */
+#include "fw_update.h"        /* BB6: A/B firmware staging */
 #include "telemetry.h"        /* BB4: RTT telemetry vitals */
+#include "cmd_channel.h"      /* RTT down-channel command processor */
 #include "crash_handler.h"    /* BB5: Crash reporter */
+#include "crash_ring.h"       /* BB5: Flash crash black-box */
+#include "boot_profile.h"     /* Boot-phase timeline marks */
+#include "task_trace.h"       /* Context-switch trace stream (RTT ch3) */
 #include "watchdog_manager.h" /* BB5: Cooperative watchdog */
 #endif
 
 #include "hardware/watchdog.h"      /* watchdog_reboot() used in hooks (both profiles) */
 #ifndef BUILD_PRODUCTION
 #include "hardware/structs/sio.h"   /* BB5: sio_hw->cpuid in crash diagnostics */
+
+AI_LOG_MODULE(main);  /* Log domain — threshold in ai_log_config.h */
 #endif
 
 // Pico W: The onboard LED is connected to the CYW43 WiFi chip,
@@ -34,6 +45,17 @@
 #define BLINKY_PRIORITY       (tskIDLE_PRIORITY + 1)
 #define BLINKY_DELAY_MS       500
 
+#ifndef BUILD_PRODUCTION
+// BB4: Runs when the persisted config becomes authoritative. With lazy
+// mount it fires from the fs_loader task after the background mount;
+// polling readers like blinky pick up the values without it.
+static void on_config_loaded(const app_config_t *cfg) {
+    LOG_INFO("Config active: v=%u, blink=%ums",
+             AI_LOG_ARG_U(cfg->config_version),
+             AI_LOG_ARG_U(cfg->blink_delay_ms));
+}
+#endif
+
 static void blinky_task(void *params) {
     (void)params;
     bool led_state = false;
@@ -87,24 +109,72 @@ int main(void) {
     printf("=== AI-Optimized FreeRTOS v0.3.0 (PRODUCTION) ===\n");
     printf("[main] Creating blinky task...\n");
 #else
+    boot_profile_mark("sysinit");
+
+    // Phase 1.45: BB6 — Boot-slot selector. Applies a PENDING update
+    // (RAM copy + reset, does not return) or counts a TESTING boot.
+    // One 28-byte XIP read when no update is in flight.
+    fw_update_boot_check();
+
     // Phase 1.5: Initialize tokenized logging subsystem (RTT Channel 1)
     ai_log_init();
+    boot_profile_mark("ai_log");
+
+#if AI_LOG_FLASH_PERSIST
+    // Phase 1.52: Locate the flash log ring's write head (XIP scan only,
+    // no erase — the persist task erases lazily before its first program)
+    log_persist_init();
+#endif
+
+    // Phase 1.55: Fixed-block pools (must precede fs_manager's cJSON use)
+    mem_pool_init();
+    boot_profile_mark("mempool");
+
+    // Phase 1.57: Inter-core mailbox rings (must precede any sender on
+    // either core — cheap, just clears the SRAM rings)
+    core_mailbox_init();
 
     // Phase 1.6: BB4 — Initialize persistent configuration (LittleFS)
     if (!fs_manager_init()) {
         printf("[main] WARNING: Persistence init failed, using defaults\n");
     }
+    fs_manager_on_config_loaded(on_config_loaded);
+    boot_profile_mark("fs_mount");
+
+    // Phase 1.62: BB4 — Index the XIP asset store (raw region, no FS).
+    // One 16-byte header read + entry-table CRC; payload CRCs are lazy.
+    if (asset_store_init()) {
+        printf("[main] Asset store: %lu asset(s) available\n",
+               (unsigned long)asset_store_count());
+    }
+    boot_profile_mark("assets");
 
+#if FAST_BOOT
+    // Phase 1.65 deferred: crash reporting (flash ring scan + possible
+    // erase + LittleFS write) runs from the supervisor's first cycle
+    // instead of the serial boot path — see supervisor_task.c.
+#else
     // Phase 1.65: BB5 — Check for crash from previous boot
     if (crash_reporter_init()) {
         printf("[main] ⚠️ Crash from previous boot detected and reported\n");
     }
+    boot_profile_mark("crashrpt");
+#endif
 
     // Phase 1.7: BB4 — Initialize telemetry subsystem (RTT Channel 2)
     telemetry_init();
+    boot_profile_mark("telem");
+
+    // Phase 1.72: RTT down-channel command input (shares channel 2)
+    cmd_channel_init();
+
+    // Phase 1.75: Context-switch trace stream (RTT Channel 3) — must be
+    // ready before the scheduler starts; the hooks fire on switch #1
+    task_trace_init();
 
     // Phase 1.8: BB5 — Initialize cooperative watchdog (Event Group created, HW WDT deferred)
     watchdog_manager_init(8000);
+    boot_profile_mark("watchdog");
 
     printf("=== AI-Optimized FreeRTOS v0.3.0 ===\n");
 
@@ -130,12 +200,41 @@ int main(void) {
         printf("[main] WARNING: Supervisor task creation failed\n");
     }
 
+    // Phase 2.6: BB2 — Start log flusher task (drains per-core rings to RTT)
+    if (!ai_log_start_flusher()) {
+        printf("[main] WARNING: Log flusher task creation failed\n");
+    }
+
+#if AI_LOG_FLASH_PERSIST
+    // Phase 2.62: Start flash log persistence (page-batched flash writes)
+    if (!log_persist_start()) {
+        printf("[main] WARNING: Log persist task creation failed\n");
+    }
+#endif
+
+    // Phase 2.65: Start task-trace flusher (drains switch events to ch3)
+    if (!task_trace_start_flusher()) {
+        printf("[main] WARNING: Task-trace flusher task creation failed\n");
+    }
+
+    // Phase 2.7: BB4 — Start background flash committer (async config saves)
+    if (!fs_manager_start_committer()) {
+        printf("[main] WARNING: Flash committer task creation failed\n");
+    }
+
+    // Phase 2.75: Start command processor (live config via RTT down-channel)
+    if (!cmd_channel_start()) {
+        printf("[main] WARNING: Command processor task creation failed\n");
+    }
+
     // BB5: Register tasks with cooperative watchdog
     watchdog_manager_register(WDG_BIT_BLINKY);
     watchdog_manager_register(WDG_BIT_SUPERVISOR);
 
     // Phase 2.8: BB5 — Start watchdog monitor task
     watchdog_manager_start();
+
+    boot_profile_mark("tasks");
 #endif
 
     // Phase 3: Start scheduler (never returns)
@@ -162,6 +261,7 @@ void vApplicationMallocFailedHook(void) {
     watchdog_hw->scratch[1] = (uint32_t)xPortGetFreeHeapSize();
     watchdog_hw->scratch[2] = 0;
     watchdog_hw->scratch[3] = core_id << 12;
+    crash_ring_write(0xDEADBAD0u, NULL);  /* Full record to flash ring */
     watchdog_reboot(0, 0, 0);
 #endif
     while (1) { __asm volatile("" ::: "memory"); }
@@ -181,6 +281,7 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
     watchdog_hw->scratch[1] = 0;
     watchdog_hw->scratch[2] = 0;
     watchdog_hw->scratch[3] = ((core_id & 0xFu) << 12) | (task_num & 0xFFFu);
+    crash_ring_write(0xDEAD57ACu, NULL);  /* Full record to flash ring */
     watchdog_reboot(0, 0, 0);
 #endif
     while (1) { __asm volatile("" ::: "memory"); }
@@ -0,0 +1,326 @@
+/**
+ * @file main_bench.c
+ * @brief On-target RTOS microbenchmark firmware — primitive cost survey.
+ *
+ * Second firmware target (sibling to app/) that measures what the
+ * platform's primitives actually cost on real silicon:
+ *
+ *   1. Context-switch latency, same-core and cross-core
+ *      (task-notification ping-pong, round trip / 2)
+ *   2. xQueueSend+xQueueReceive pair (8-byte items, no blocking)
+ *   3. core_mailbox try_send+try_recv pair (the lock-free comparison)
+ *   4. xEventGroupSetBits with no waiters
+ *   5. taskENTER_CRITICAL/taskEXIT_CRITICAL pair
+ *   6. _ai_log_write end to end (2 args, ring + amortized flush)
+ *   7. flash_safe_op with a no-op callback (dual-core lockout handshake)
+ *   8. flash_safe_op erasing one 4KB sector (worst-case stall)
+ *
+ * Results go out as BENCH_PKT_RESULT packets on RTT Channel 2 (decoder:
+ * tools/bench/bench_decoder.py) and as human-readable lines on stdio.
+ * Re-run after every FreeRTOS-Kernel or pico-sdk bump in lib/ and diff
+ * the ns_per_op numbers — primitive-cost regressions surface here, not
+ * as mystery deadline misses in the application.
+ *
+ * Timing uses the 1MHz TIMERAWL counter: sub-microsecond primitives
+ * are timed in bulk (total / iterations → ns_per_op) and per-iteration
+ * min/max are only reported where one operation spans multiple ticks.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "event_groups.h"
+
+#include "system_init.h"
+#include "core_mailbox.h"
+#include "flash_safe.h"
+#include "fw_update.h"          /* Staging-slot macros — scratch sector */
+#include "ai_log.h"
+#include "log_ring.h"
+
+#include "pico/stdlib.h"
+#include "SEGGER_RTT.h"
+#include "hardware/timer.h"     /* timer_hw->timerawl */
+#include "hardware/flash.h"     /* flash_range_erase, FLASH_SECTOR_SIZE */
+
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * Result Packet (RTT Channel 2)
+ * ========================================================================= */
+
+/** One benchmark result.
+ *  Layout: [type:1][id:1][name:12][iters:4][total_us:4][ns_per_op:4]
+ *  [min_us:4][max_us:4] — 34 bytes, little-endian. min/max are 0 for
+ *  bulk-timed benchmarks (one op below timer resolution). */
+#define BENCH_PKT_RESULT    0xB0
+
+/** End-of-run marker: [type:1][result_count:1]. */
+#define BENCH_PKT_DONE      0xB1
+
+#define BENCH_RTT_CHANNEL   2
+#define BENCH_NAME_LEN      12
+
+static char s_bench_rtt_buffer[1024];
+
+/** Scratch sector for the erase benchmark — the LAST sector of the
+ *  update staging slot. A bench image never has an update in flight,
+ *  and the slot is fully rewritten by any later fw_update_begin(). */
+#define BENCH_SCRATCH_OFFSET \
+    (FW_UPDATE_STAGING_OFFSET + FW_UPDATE_SLOT_SIZE - FLASH_SECTOR_SIZE)
+
+static uint8_t s_result_count;
+
+static void _emit_result(uint8_t id, const char *name, uint32_t iters,
+                         uint32_t total_us, uint32_t min_us, uint32_t max_us) {
+    uint32_t ns_per_op = (uint32_t)(((uint64_t)total_us * 1000u) / iters);
+
+    uint8_t packet[34];
+    unsigned pos = 0;
+    packet[pos++] = BENCH_PKT_RESULT;
+    packet[pos++] = id;
+    memset(&packet[pos], 0, BENCH_NAME_LEN);
+    strncpy((char *)&packet[pos], name, BENCH_NAME_LEN);
+    pos += BENCH_NAME_LEN;
+    memcpy(&packet[pos], &iters, 4);     pos += 4;
+    memcpy(&packet[pos], &total_us, 4);  pos += 4;
+    memcpy(&packet[pos], &ns_per_op, 4); pos += 4;
+    memcpy(&packet[pos], &min_us, 4);    pos += 4;
+    memcpy(&packet[pos], &max_us, 4);    pos += 4;
+
+    SEGGER_RTT_Write(BENCH_RTT_CHANNEL, packet, pos);
+    s_result_count++;
+
+    printf("[bench] %-12s iters=%lu total=%luus ns/op=%lu min=%luus max=%luus\n",
+           name, (unsigned long)iters, (unsigned long)total_us,
+           (unsigned long)ns_per_op, (unsigned long)min_us,
+           (unsigned long)max_us);
+}
+
+/* =========================================================================
+ * 1. Context-Switch Latency — notification ping-pong
+ * ========================================================================= */
+
+#define CTX_ITERS       10000u
+#define BULK_ITERS      100000u
+#define LOG_ITERS       50000u
+#define FLASH_ITERS     50u
+
+static TaskHandle_t s_bench_handle;
+static TaskHandle_t s_partner_handle;
+
+/** Partner side of the ping-pong: wait, answer, repeat. */
+static void _partner_task(void *params) {
+    (void)params;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xTaskNotifyGive(s_bench_handle);
+    }
+}
+
+/**
+ * @brief Round-trip ping-pong with the partner pinned to one core.
+ *
+ * Each iteration is two full context switches (out to the partner and
+ * back), so switch latency ≈ round trip / 2 — reported ns_per_op is
+ * already halved. min/max are per ROUND TRIP in µs.
+ */
+static void _bench_ctx_switch(uint8_t id, const char *name,
+                              UBaseType_t partner_core) {
+    vTaskCoreAffinitySet(s_partner_handle, 1u << partner_core);
+    vTaskDelay(pdMS_TO_TICKS(10));      /* Let the partner migrate + block */
+
+    uint32_t min_us = UINT32_MAX, max_us = 0;
+    uint32_t t0 = timer_hw->timerawl;
+
+    for (uint32_t i = 0; i < CTX_ITERS; i++) {
+        uint32_t it0 = timer_hw->timerawl;
+        xTaskNotifyGive(s_partner_handle);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t dt = timer_hw->timerawl - it0;
+        if (dt < min_us) min_us = dt;
+        if (dt > max_us) max_us = dt;
+    }
+
+    uint32_t total = timer_hw->timerawl - t0;
+    /* Halve: one round trip = two switches */
+    _emit_result(id, name, CTX_ITERS * 2, total, min_us, max_us);
+}
+
+/* =========================================================================
+ * 2-5. Kernel Primitive Costs — bulk timed
+ * ========================================================================= */
+
+static void _bench_queue(void) {
+    QueueHandle_t q = xQueueCreate(8, sizeof(core_mailbox_msg_t));
+    configASSERT(q != NULL);
+    core_mailbox_msg_t msg = { .cmd = 1, .arg = 2 };
+
+    uint32_t t0 = timer_hw->timerawl;
+    for (uint32_t i = 0; i < BULK_ITERS; i++) {
+        xQueueSend(q, &msg, 0);
+        xQueueReceive(q, &msg, 0);
+    }
+    uint32_t total = timer_hw->timerawl - t0;
+    vQueueDelete(q);
+    _emit_result(2, "queue_pair", BULK_ITERS, total, 0, 0);
+}
+
+static void _bench_mailbox(void) {
+    core_mailbox_msg_t msg = { .cmd = 1, .arg = 2 };
+
+    uint32_t t0 = timer_hw->timerawl;
+    for (uint32_t i = 0; i < BULK_ITERS; i++) {
+        core_mailbox_try_send(0, &msg);
+        core_mailbox_try_recv(&msg);
+    }
+    uint32_t total = timer_hw->timerawl - t0;
+    _emit_result(3, "mbox_pair", BULK_ITERS, total, 0, 0);
+}
+
+static void _bench_event_group(void) {
+    EventGroupHandle_t eg = xEventGroupCreate();
+    configASSERT(eg != NULL);
+
+    uint32_t t0 = timer_hw->timerawl;
+    for (uint32_t i = 0; i < BULK_ITERS; i++) {
+        xEventGroupSetBits(eg, 1);
+    }
+    uint32_t total = timer_hw->timerawl - t0;
+    vEventGroupDelete(eg);
+    _emit_result(4, "event_set", BULK_ITERS, total, 0, 0);
+}
+
+static void _bench_critical(void) {
+    uint32_t t0 = timer_hw->timerawl;
+    for (uint32_t i = 0; i < BULK_ITERS; i++) {
+        taskENTER_CRITICAL();
+        taskEXIT_CRITICAL();
+    }
+    uint32_t total = timer_hw->timerawl - t0;
+    _emit_result(5, "crit_pair", BULK_ITERS, total, 0, 0);
+}
+
+/* =========================================================================
+ * 6. Log Write Path — producer + amortized flusher drain
+ * ========================================================================= */
+
+static void _bench_log_write(void) {
+    ai_log_arg_t args[2];
+
+    uint32_t t0 = timer_hw->timerawl;
+    for (uint32_t i = 0; i < LOG_ITERS; i++) {
+        args[0] = AI_LOG_ARG_I((int32_t)i);
+        args[1] = AI_LOG_ARG_I(-42);
+        _ai_log_write(AI_LOG_LEVEL_INFO, 0xBE4CBE4Cu, args, 2);
+        if ((i & 15u) == 15u) {
+            log_ring_flush();   /* Same cadence the flusher amortizes to */
+        }
+    }
+    log_ring_flush();
+    uint32_t total = timer_hw->timerawl - t0;
+    _emit_result(6, "log_write", LOG_ITERS, total, 0, 0);
+}
+
+/* =========================================================================
+ * 7-8. Flash Lockout Stalls — per-op min/max meaningful here
+ * ========================================================================= */
+
+static void _flash_nop(void *param) {
+    (void)param;
+}
+
+static void _flash_erase_cb(void *param) {
+    (void)param;
+    flash_range_erase(BENCH_SCRATCH_OFFSET, FLASH_SECTOR_SIZE);
+}
+
+static void _bench_flash(uint8_t id, const char *name,
+                         void (*op)(void *)) {
+    uint32_t min_us = UINT32_MAX, max_us = 0;
+    uint32_t t0 = timer_hw->timerawl;
+
+    for (uint32_t i = 0; i < FLASH_ITERS; i++) {
+        uint32_t it0 = timer_hw->timerawl;
+        flash_safe_op(op, NULL);
+        uint32_t dt = timer_hw->timerawl - it0;
+        if (dt < min_us) min_us = dt;
+        if (dt > max_us) max_us = dt;
+    }
+
+    uint32_t total = timer_hw->timerawl - t0;
+    _emit_result(id, name, FLASH_ITERS, total, min_us, max_us);
+}
+
+/* =========================================================================
+ * Benchmark Driver Task
+ * ========================================================================= */
+
+static void _bench_task(void *params) {
+    (void)params;
+
+    printf("[bench] Starting primitive survey on FreeRTOS %s\n",
+           tskKERNEL_VERSION_NUMBER);
+
+    /* Pin the driver to Core 0 so "same-core" means what it says */
+    vTaskCoreAffinitySet(NULL, 1u << 0);
+
+    _bench_ctx_switch(0, "ctx_same", 0);
+    _bench_ctx_switch(1, "ctx_cross", 1);
+    _bench_queue();
+    _bench_mailbox();
+    _bench_event_group();
+    _bench_critical();
+    _bench_log_write();
+    _bench_flash(7, "flash_lockout", _flash_nop);
+    _bench_flash(8, "flash_erase4k", _flash_erase_cb);
+
+    uint8_t done[2] = { BENCH_PKT_DONE, s_result_count };
+    SEGGER_RTT_Write(BENCH_RTT_CHANNEL, done, sizeof(done));
+
+    printf("[bench] Done — %u results emitted\n", s_result_count);
+
+    vTaskDelete(s_partner_handle);
+    vTaskDelete(NULL);
+}
+
+/* =========================================================================
+ * Main
+ * ========================================================================= */
+
+int main(void) {
+    system_init();
+
+    printf("=== AI-Optimized FreeRTOS — RTOS microbenchmarks ===\n");
+
+    ai_log_init();
+    core_mailbox_init();
+
+    /* Results channel — same RTT slot telemetry uses in the app image,
+     * so the existing OpenOCD port mapping works unchanged. Blocking
+     * writes are fine here: a benchmark image assumes a host. */
+    SEGGER_RTT_ConfigUpBuffer(
+        BENCH_RTT_CHANNEL,
+        "Bench",
+        s_bench_rtt_buffer,
+        sizeof(s_bench_rtt_buffer),
+        SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL
+    );
+
+    BaseType_t ok;
+    ok = xTaskCreate(_partner_task, "bench_peer",
+                     configMINIMAL_STACK_SIZE, NULL,
+                     tskIDLE_PRIORITY + 2, &s_partner_handle);
+    configASSERT(ok == pdPASS);
+
+    ok = xTaskCreate(_bench_task, "bench",
+                     configMINIMAL_STACK_SIZE * 2, NULL,
+                     tskIDLE_PRIORITY + 2, &s_bench_handle);
+    configASSERT(ok == pdPASS);
+
+    vTaskStartScheduler();
+
+    /* Never reached */
+    for (;;) { }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file cmd_channel.h
+ * @brief RTT down-channel command processor — public API.
+ *
+ * Reads framed commands from an RTT DOWN buffer (host → target) and
+ * applies them live: config field updates, supervisor interval
+ * changes, config flush, one-shot diagnostics. Tuning a parameter no
+ * longer costs a reboot + LittleFS remount — the host writes a frame,
+ * the device applies it within one poll period.
+ *
+ * The down buffer shares channel number 2 with the telemetry up
+ * buffer, so the same OpenOCD RTT TCP port (9092) carries commands
+ * down and vitals/diagnostics up — one connection per tuning session
+ * (tools/telemetry/config_sync.py).
+ *
+ * Wire format (little-endian, one frame per command):
+ *
+ *   [magic:1 = 0xC3][cmd:1][len:1][payload:len][chk:1]
+ *
+ *   chk = XOR of cmd, len, and every payload byte. A frame that fails
+ *   the magic, length, or checksum is discarded one byte at a time
+ *   until the parser resynchronizes on the next magic.
+ *
+ * Commands:
+ *
+ *   CMD_SET_CONFIG (0x01), payload 9:
+ *     [blink_delay_ms:4][log_level:1][telemetry_interval_ms:4]
+ *     Same no-change sentinels as fs_manager_update_config():
+ *     blink 0, level 0xFF, interval 0. Applied live (runtime log
+ *     level, supervisor interval) AND scheduled for persistence.
+ *
+ *   CMD_SET_INTERVAL (0x02), payload 4:
+ *     [interval_ms:4] — supervisor interval only, NOT persisted.
+ *     For rapid sweeps that shouldn't wear the config sector.
+ *
+ *   CMD_FLUSH_CONFIG (0x03), payload 0:
+ *     Block until any pending config update is on flash
+ *     (fs_manager_flush()) — send before a deliberate reboot.
+ *
+ *   CMD_GET_DIAG (0x04), payload 0:
+ *     Force a full vitals snapshot on the next supervisor cycle and
+ *     flush it off the device (telemetry_request_snapshot()).
+ */
+
+#ifndef CMD_CHANNEL_H
+#define CMD_CHANNEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Channel Configuration
+ * ========================================================================= */
+
+/** RTT DOWN-buffer number. Shares index 2 with the telemetry up
+ *  buffer — up and down buffers are independent arrays, and OpenOCD
+ *  maps both directions of a channel onto one TCP port. */
+#define CMD_RTT_CHANNEL             2
+
+/** Down-buffer size (bytes). Commands are tiny (≤ 14B frames); 256B
+ *  absorbs a whole scripted burst between polls. */
+#define CMD_RTT_BUFFER_SIZE         256
+
+/** Poll period of the processor task. 50ms keeps command latency
+ *  imperceptible at negligible idle cost (one RTT read per poll). */
+#define CMD_POLL_PERIOD_MS          50
+
+/** Processor task priority — just above idle, same tier as the other
+ *  background services (supervisor, flushers, committer). */
+#define CMD_TASK_PRIORITY           (tskIDLE_PRIORITY + 1)
+
+/** Processor task stack (words). Parser + fs_manager/telemetry calls;
+ *  fs_manager_flush() can run a LittleFS write inline. */
+#define CMD_TASK_STACK_SIZE         (configMINIMAL_STACK_SIZE * 2)
+
+/* =========================================================================
+ * Frame Format
+ * ========================================================================= */
+
+/** First byte of every frame — resync anchor after a corrupt frame. */
+#define CMD_FRAME_MAGIC             0xC3
+
+/** Largest accepted payload. Bigger `len` bytes are treated as
+ *  corruption and resynced past. */
+#define CMD_MAX_PAYLOAD             32
+
+/** Command IDs (see file header for payload layouts). */
+#define CMD_SET_CONFIG              0x01
+#define CMD_SET_INTERVAL            0x02
+#define CMD_FLUSH_CONFIG            0x03
+#define CMD_GET_DIAG                0x04
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Configure the RTT down buffer for command input.
+ *
+ * ⚠️ Call from main() before the scheduler starts (after
+ * telemetry_init(), which owns the matching up buffer).
+ */
+void cmd_channel_init(void);
+
+/**
+ * @brief Start the command processor task.
+ *
+ * Creates the background task that polls the down buffer every
+ * CMD_POLL_PERIOD_MS and dispatches complete frames.
+ *
+ * @return true if the task was created
+ */
+bool cmd_channel_start(void);
+
+/** Frames dispatched successfully since boot. */
+uint32_t cmd_channel_frames_ok(void);
+
+/** Bytes/frames rejected (bad magic, length, checksum, or command). */
+uint32_t cmd_channel_frames_bad(void);
+
+#endif /* CMD_CHANNEL_H */
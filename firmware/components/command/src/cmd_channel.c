@@ -0,0 +1,221 @@
+/**
+ * @file cmd_channel.c
+ * @brief RTT down-channel command processor — live config and control.
+ *
+ * A background task polls the channel-2 DOWN buffer, reassembles
+ * framed commands (frames may arrive split across polls), and applies
+ * them: fs_manager_update_config() for persisted fields plus direct
+ * pushes to the running consumers (runtime log level, supervisor
+ * interval). See cmd_channel.h for the wire format.
+ *
+ * Single consumer: only this task reads the down buffer, so the RTT
+ * read needs no cross-core locking (same reasoning as the SPSC log
+ * rings). Corrupt input can only cost discarded bytes — the parser
+ * resynchronizes on the next frame magic.
+ */
+
+#include "cmd_channel.h"
+#include "telemetry.h"      /* telemetry_set_interval / request_snapshot */
+#include "fs_manager.h"     /* fs_manager_update_config / flush */
+#include "ai_log.h"         /* ai_log_set_runtime_level */
+#include "SEGGER_RTT.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * Static RTT down buffer for channel 2
+ * ========================================================================= */
+
+static char s_cmd_rtt_buffer[CMD_RTT_BUFFER_SIZE];
+static bool s_cmd_initialized = false;
+
+/** Dispatch counters — read lock-free by diagnostics (aligned words). */
+static volatile uint32_t s_frames_ok;
+static volatile uint32_t s_frames_bad;
+
+/* =========================================================================
+ * Frame Parser
+ * ========================================================================= */
+
+/** Header bytes before the payload: [magic][cmd][len]. */
+#define CMD_FRAME_HEADER    3
+
+/** Reassembly buffer — one worst-case frame plus a partial next one. */
+static uint8_t s_acc[2 * (CMD_FRAME_HEADER + CMD_MAX_PAYLOAD + 1)];
+static unsigned s_acc_len;
+
+/**
+ * @brief Apply one validated command frame.
+ */
+static void _dispatch(uint8_t cmd, const uint8_t *payload, unsigned len) {
+    switch (cmd) {
+    case CMD_SET_CONFIG: {
+        if (len != 9) break;
+        uint32_t blink, interval;
+        memcpy(&blink, &payload[0], 4);
+        uint8_t level = payload[4];
+        memcpy(&interval, &payload[5], 4);
+
+        /* Persist (committer coalesces the flash write)... */
+        fs_manager_update_config(blink, level, interval);
+
+        /* ...and push to the running consumers right now. The blinky
+         * task re-reads fs_manager_get_config() every loop, so the
+         * in-RAM update above already covers it. */
+        if (level != 0xFF) ai_log_set_runtime_level(level);
+        if (interval != 0) telemetry_set_interval(interval);
+
+        printf("[cmd] Config update: blink=%lu, level=%u, interval=%lu\n",
+               (unsigned long)blink, level, (unsigned long)interval);
+        s_frames_ok++;
+        return;
+    }
+
+    case CMD_SET_INTERVAL: {
+        if (len != 4) break;
+        uint32_t interval;
+        memcpy(&interval, payload, 4);
+        /* Live only — sweeps must not wear the config sector */
+        telemetry_set_interval(interval);
+        s_frames_ok++;
+        return;
+    }
+
+    case CMD_FLUSH_CONFIG:
+        if (len != 0) break;
+        printf("[cmd] Config flush %s\n",
+               fs_manager_flush() ? "complete" : "FAILED");
+        s_frames_ok++;
+        return;
+
+    case CMD_GET_DIAG:
+        if (len != 0) break;
+        telemetry_request_snapshot();
+        printf("[cmd] Diagnostics snapshot requested\n");
+        s_frames_ok++;
+        return;
+
+    default:
+        break;
+    }
+
+    printf("[cmd] Rejected frame: cmd=0x%02x, len=%u\n", cmd, len);
+    s_frames_bad++;
+}
+
+/**
+ * @brief Read new bytes and dispatch every complete frame.
+ *
+ * Incomplete tails stay in the reassembly buffer for the next poll.
+ * On any malformed prefix a single byte is dropped so the parser
+ * hunts forward to the next CMD_FRAME_MAGIC.
+ */
+static void _poll_once(void) {
+    s_acc_len += SEGGER_RTT_Read(CMD_RTT_CHANNEL, &s_acc[s_acc_len],
+                                 sizeof(s_acc) - s_acc_len);
+
+    unsigned pos = 0;
+    while (s_acc_len - pos >= CMD_FRAME_HEADER) {
+        if (s_acc[pos] != CMD_FRAME_MAGIC) {
+            pos++;                          /* Resync: hunt for magic */
+            s_frames_bad++;
+            continue;
+        }
+
+        uint8_t cmd = s_acc[pos + 1];
+        uint8_t len = s_acc[pos + 2];
+        if (len > CMD_MAX_PAYLOAD) {
+            pos++;                          /* Corrupt length — resync */
+            s_frames_bad++;
+            continue;
+        }
+
+        unsigned frame_len = CMD_FRAME_HEADER + len + 1;    /* +checksum */
+        if (s_acc_len - pos < frame_len) break;             /* Partial */
+
+        uint8_t chk = (uint8_t)(cmd ^ len);
+        for (unsigned i = 0; i < len; i++) {
+            chk ^= s_acc[pos + CMD_FRAME_HEADER + i];
+        }
+
+        if (chk != s_acc[pos + frame_len - 1]) {
+            pos++;                          /* Bad checksum — resync */
+            s_frames_bad++;
+            continue;
+        }
+
+        _dispatch(cmd, &s_acc[pos + CMD_FRAME_HEADER], len);
+        pos += frame_len;
+    }
+
+    /* Keep the unconsumed tail at the front for the next read */
+    if (pos > 0) {
+        memmove(s_acc, &s_acc[pos], s_acc_len - pos);
+        s_acc_len -= pos;
+    }
+}
+
+/* =========================================================================
+ * Processor Task
+ * ========================================================================= */
+
+static void _cmd_task(void *params) {
+    (void)params;
+
+    printf("[cmd] Processor started, poll=%dms\n", CMD_POLL_PERIOD_MS);
+
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        _poll_once();
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CMD_POLL_PERIOD_MS));
+    }
+}
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+void cmd_channel_init(void) {
+    SEGGER_RTT_ConfigDownBuffer(
+        CMD_RTT_CHANNEL,
+        "AiCmd",
+        s_cmd_rtt_buffer,
+        sizeof(s_cmd_rtt_buffer),
+        SEGGER_RTT_MODE_NO_BLOCK_SKIP
+    );
+
+    s_cmd_initialized = true;
+
+    printf("[cmd] Init complete, RTT down-ch%d, buf=%dB\n",
+           CMD_RTT_CHANNEL, CMD_RTT_BUFFER_SIZE);
+}
+
+bool cmd_channel_start(void) {
+    if (!s_cmd_initialized) return false;
+
+    BaseType_t ret = xTaskCreate(
+        _cmd_task,
+        "cmd_proc",
+        CMD_TASK_STACK_SIZE,
+        NULL,
+        CMD_TASK_PRIORITY,
+        NULL
+    );
+
+    if (ret != pdPASS) {
+        printf("[cmd] Failed to create processor task\n");
+        return false;
+    }
+    return true;
+}
+
+uint32_t cmd_channel_frames_ok(void) {
+    return s_frames_ok;
+}
+
+uint32_t cmd_channel_frames_bad(void) {
+    return s_frames_bad;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file crash_ring.h
+ * @brief BB5: Flash-backed crash black-box — full context across reboot.
+ *
+ * The watchdog scratch registers carry 16 bytes — enough for a magic,
+ * PC, LR and a packed task number, not enough to say WHY. The crash
+ * ring persists a full record per crash into FS_CRASH_RING_SIZE of raw
+ * flash (see fs_config.h): stacked registers, a scanned stack
+ * backtrace, and the most recent tokenized log bytes from both cores'
+ * rings.
+ *
+ * Fault-context constraints drive the design:
+ *   - Slots are pre-erased at boot (crash_ring_init), so the fault
+ *     path only does one bounded flash_range_program (~1KB, low ms).
+ *   - No filesystem, no locks, no malloc; the writer and its helpers
+ *     live in SRAM like crash_handler_c.
+ *   - The dual-core flash lockout cannot be negotiated from a fault.
+ *     We program anyway: the other core may stall on XIP for the
+ *     duration, but the system is about to watchdog-reboot regardless.
+ *
+ * The scratch-register path stays as the always-works fallback — if
+ * XIP is corrupted the ring write may fail, the scratch write cannot.
+ */
+
+#ifndef CRASH_RING_H
+#define CRASH_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Record Geometry
+ * ========================================================================= */
+
+/** One record per crash, padded to a flash-page multiple. */
+#define CRASH_RING_RECORD_SIZE      1024
+
+/** Slots in the ring: FS_CRASH_RING_SIZE / CRASH_RING_RECORD_SIZE = 8. */
+#define CRASH_RING_SLOT_COUNT       8
+
+/** Maximum backtrace entries scanned from the faulting stack. */
+#define CRASH_RING_BT_MAX           16
+
+/** Recent log bytes captured per core (raw log-ring tail). */
+#define CRASH_RING_LOG_BYTES        384
+
+/** Record magic ("SARC" little-endian → reads "CRAS" in a hex dump). */
+#define CRASH_RING_MAGIC            0x43524153u
+
+/* =========================================================================
+ * Record Layout
+ * ========================================================================= */
+
+/**
+ * @brief One crash record as programmed to flash.
+ *
+ * `reason` reuses the scratch-register magics (0xDEADFA11 HardFault,
+ * 0xDEAD57AC stack overflow, 0xDEADBAD0 malloc failure) so host
+ * tooling shares one vocabulary. `regs` holds the hardware-stacked
+ * exception frame [R0,R1,R2,R3,R12,LR,PC,xPSR]; all zero when the
+ * crash path had no frame (hooks). `log_bytes` is the raw tail of
+ * each core's log ring — entry framing may start mid-packet, the host
+ * decoder resynchronizes.
+ */
+typedef struct {
+    uint32_t magic;                 /**< CRASH_RING_MAGIC */
+    uint32_t seq;                   /**< Monotonic record number */
+    uint32_t reason;                /**< Scratch-style crash magic */
+    uint32_t tick;                  /**< xTaskGetTickCount() at crash */
+    uint8_t  core_id;               /**< Faulting core (0 or 1) */
+    uint8_t  bt_count;              /**< Valid entries in backtrace[] */
+    uint16_t task_number;           /**< uxTaskGetTaskNumber() or 0 */
+    uint32_t regs[8];               /**< Stacked R0-R3,R12,LR,PC,xPSR */
+    uint32_t backtrace[CRASH_RING_BT_MAX]; /**< Code addresses off the stack */
+    uint16_t log_len[2];            /**< Captured log bytes per core */
+    uint8_t  log_bytes[2][CRASH_RING_LOG_BYTES];
+} __attribute__((packed)) crash_record_t;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Prepare the crash ring for this boot.
+ *
+ * Scans the slots for the highest sequence number and pre-erases the
+ * next slot's sector if needed, so crash_ring_write() never has to
+ * erase in fault context.
+ *
+ * Pre-scheduler the erase runs bare (Core 1 not yet running); when
+ * init is deferred past scheduler start (fast-boot profile) the erase
+ * goes through the flash_safe_op dual-core lockout instead.
+ */
+void crash_ring_init(void);
+
+/**
+ * @brief Persist a crash record to the pre-erased slot.
+ *
+ * Safe from HardFault context and FreeRTOS failure hooks: single
+ * bounded flash_range_program, no locks, code in SRAM.
+ *
+ * @param reason       Scratch-style crash magic (0xDEADFA11, ...)
+ * @param stack_frame  Hardware exception frame, or NULL from hooks
+ */
+void crash_ring_write(uint32_t reason, const uint32_t *stack_frame);
+
+/**
+ * @brief Most recent valid record, read in place via XIP.
+ *
+ * @return Pointer into memory-mapped flash, or NULL if the ring is empty
+ */
+const crash_record_t *crash_ring_latest(void);
+
+#endif /* CRASH_RING_H */
@@ -21,6 +21,19 @@
  * #define WDG_BIT_SENSOR       ((EventBits_t)(1 << 3))
  * ... up to bit 23 */
 
+/* =========================================================================
+ * Fast Check-in Slots — lock-free path for high-rate loops.
+ *
+ * xEventGroupSetBits() takes a critical section (an SMP spin lock on
+ * RP2040) per call — fine at blinky rates, too expensive inside a kHz
+ * control loop. Fast slots are plain flag bytes: check-in is a single
+ * byte store (atomic on Cortex-M0+), the monitor polls and clears them
+ * each check period. Up to 8 slots; slow tasks keep the Event Group API.
+ * ========================================================================= */
+
+/** Maximum number of fast check-in slots. */
+#define WDG_FAST_MAX_SLOTS      8
+
 /* =========================================================================
  * Configuration
  * ========================================================================= */
@@ -73,6 +86,37 @@ void watchdog_manager_register(EventBits_t task_bit);
  */
 void watchdog_manager_checkin(EventBits_t task_bit);
 
+/**
+ * @brief Register a fast (lock-free) check-in slot.
+ *
+ * Call in main() before watchdog_manager_start(). The name is kept
+ * for the timeout diagnostic printout.
+ *
+ * @param name  Short task name (pointer is stored, use a literal)
+ * @return Slot index for watchdog_manager_checkin_fast(), or -1 if
+ *         all WDG_FAST_MAX_SLOTS are taken
+ */
+int watchdog_manager_register_fast(const char *name);
+
+/** Fast-slot flag bytes — written by hot tasks, polled by the monitor.
+ *  Internal; use watchdog_manager_checkin_fast(). */
+extern volatile uint8_t g_wdg_fast_flags[WDG_FAST_MAX_SLOTS];
+
+/**
+ * @brief Lock-free check-in from a hot loop.
+ *
+ * A single byte store — no critical section, no scheduler interaction.
+ * Aligned byte stores are atomic on Cortex-M0+, and the monitor only
+ * ever clears a flag it has already observed set, so no ordering
+ * stronger than the store itself is needed. Safe at any call rate and
+ * from either core.
+ *
+ * @param slot  Index from watchdog_manager_register_fast()
+ */
+static inline void watchdog_manager_checkin_fast(int slot) {
+    g_wdg_fast_flags[slot] = 1;
+}
+
 /**
  * @brief Start the watchdog monitor task.
  *
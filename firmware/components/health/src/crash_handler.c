@@ -8,6 +8,7 @@
  */
 
 #include "crash_handler.h"
+#include "crash_ring.h"
 #include "hardware/watchdog.h"   /* watchdog_hw, watchdog_reboot */
 #include "pico/platform.h"      /* __no_inline_not_in_flash_func */
 #include "hardware/structs/sio.h" /* sio_hw for get_core_num() */
@@ -57,6 +58,11 @@ void __no_inline_not_in_flash_func(crash_handler_c)(uint32_t *stack_frame) {
     watchdog_hw->scratch[2] = lr;
     watchdog_hw->scratch[3] = packed;
 
+    /* Persist the full record (registers, backtrace, recent logs) to
+     * the flash crash ring. Best-effort: scratch is already written,
+     * so even if this faults again the minimal report survives. */
+    crash_ring_write(CRASH_MAGIC_SENTINEL, stack_frame);
+
     /* Trigger immediate watchdog reboot.
      * watchdog_reboot(0, 0, 0) does NOT touch scratch[0-3].
      * It only writes scratch[4-7] (Pico SDK boot target). */
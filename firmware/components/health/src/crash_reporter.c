@@ -5,9 +5,15 @@
  * On boot, checks watchdog scratch registers for crash data from the
  * previous boot. If found, decodes it, prints a crash report to RTT
  * (Channel 0 via printf), and persists to LittleFS /crash/latest.json.
+ *
+ * When the flash crash ring holds a matching record (crash_ring.h),
+ * the report includes the stacked registers, the scanned backtrace,
+ * and the captured log-ring tails — feed latest.json to
+ * tools/health/crash_decoder.py for symbolized output.
  */
 
 #include "crash_handler.h"
+#include "crash_ring.h"
 #include "watchdog_hal.h"
 #include "fs_manager.h"
 #include "fs_config.h"
@@ -23,8 +29,29 @@
 static bool s_crash_detected = false;
 static crash_data_t s_crash_data;
 
-/* Forward declaration */
-static void _save_crash_to_fs(void);
+/* =========================================================================
+ * Torn-record defense
+ *
+ * The ring validates records by magic alone, and the fault-path program
+ * is the most power-suspect moment in the system — a torn write can
+ * leave the magic intact with garbage counts. Every consumer below
+ * clamps a record's variable-length fields to the struct's real
+ * capacity before using them as loop bounds.
+ * ========================================================================= */
+
+static unsigned _rec_bt_count(const crash_record_t *rec) {
+    return (rec->bt_count > CRASH_RING_BT_MAX) ? CRASH_RING_BT_MAX
+                                               : rec->bt_count;
+}
+
+static unsigned _rec_log_len(const crash_record_t *rec, unsigned core) {
+    return (rec->log_len[core] > CRASH_RING_LOG_BYTES) ? CRASH_RING_LOG_BYTES
+                                                       : rec->log_len[core];
+}
+
+/* Forward declarations */
+static void _save_crash_to_fs(const crash_record_t *rec);
+static void _report_ring_record(const crash_record_t *rec);
 
 /* =========================================================================
  * Public API
@@ -33,6 +60,10 @@ static void _save_crash_to_fs(void);
 bool crash_reporter_init(void) {
     s_crash_detected = false;
 
+    /* Prepare the flash crash ring for THIS boot (slot scan + pre-erase).
+     * Must happen pre-scheduler — see crash_ring_init(). */
+    crash_ring_init();
+
     /* Phase 1: Check if last reboot was watchdog-caused AND magic is valid */
     if (!watchdog_hal_caused_reboot()) {
         printf("[crash_reporter] Clean boot (not watchdog-caused)\n");
@@ -40,7 +71,11 @@ bool crash_reporter_init(void) {
     }
 
     uint32_t magic = watchdog_hal_get_scratch(CRASH_SCRATCH_MAGIC);
-    if (magic != CRASH_MAGIC_SENTINEL) {
+    /* HardFault plus the hook magics (stack overflow, malloc failure)
+     * all leave flash ring records worth reporting. */
+    bool known = (magic == CRASH_MAGIC_SENTINEL ||
+                  magic == 0xDEAD57ACu || magic == 0xDEADBAD0u);
+    if (!known) {
         printf("[crash_reporter] Watchdog reboot detected, but no crash data (magic=0x%08lx)\n",
                (unsigned long)magic);
         return false;
@@ -71,8 +106,18 @@ bool crash_reporter_init(void) {
     printf("======================================================\n");
     printf("\n");
 
+    /* Phase 3.5: Flash ring record — full context if it matches this
+     * crash (same reason; the ring holds at most one record per boot). */
+    const crash_record_t *rec = crash_ring_latest();
+    if (rec != NULL && rec->reason != magic) {
+        rec = NULL;  /* Stale record from an older crash */
+    }
+    if (rec != NULL) {
+        _report_ring_record(rec);
+    }
+
     /* Phase 4: Persist to LittleFS /crash/latest.json */
-    _save_crash_to_fs();
+    _save_crash_to_fs(rec);
 
     /* Phase 5: Clear scratch[0] to prevent re-reporting */
     watchdog_hal_set_scratch(CRASH_SCRATCH_MAGIC, 0);
@@ -80,6 +125,32 @@ bool crash_reporter_init(void) {
     return true;
 }
 
+/**
+ * @brief Print the flash ring record: registers, backtrace, log tails.
+ */
+static void _report_ring_record(const crash_record_t *rec) {
+    static const char *const REG_NAMES[8] = {
+        "R0", "R1", "R2", "R3", "R12", "LR", "PC", "xPSR"
+    };
+
+    printf("[crash_reporter] Flash ring record #%lu (tick=%lu):\n",
+           (unsigned long)rec->seq, (unsigned long)rec->tick);
+
+    for (unsigned i = 0; i < 8; i++) {
+        printf("  %-4s = 0x%08lx%s", REG_NAMES[i],
+               (unsigned long)rec->regs[i], (i % 4 == 3) ? "\n" : " ");
+    }
+
+    unsigned bt_count = _rec_bt_count(rec);
+    printf("  Backtrace (%u candidate return addresses):\n", bt_count);
+    for (unsigned i = 0; i < bt_count; i++) {
+        printf("    #%u: 0x%08lx\n", i, (unsigned long)rec->backtrace[i]);
+    }
+
+    printf("  Captured log tail: core0=%uB core1=%uB (see latest.json)\n",
+           _rec_log_len(rec, 0), _rec_log_len(rec, 1));
+}
+
 bool crash_reporter_has_crash(void) {
     return s_crash_detected;
 }
@@ -92,15 +163,48 @@ const crash_data_t *crash_reporter_get_data(void) {
  * Internal — LittleFS Persistence
  * ========================================================================= */
 
-static void _save_crash_to_fs(void) {
+/**
+ * @brief Append a byte array to the JSON buffer as a hex string value.
+ */
+static int _append_hex(char *buf, int pos, int cap,
+                       const uint8_t *data, unsigned len) {
+    for (unsigned i = 0; i < len && pos + 3 < cap; i++) {
+        pos += snprintf(buf + pos, (size_t)(cap - pos), "%02x", data[i]);
+    }
+    return pos;
+}
+
+/**
+ * @brief Clamp the running JSON length to the buffer capacity.
+ *
+ * snprintf returns the WOULD-BE length on truncation, so an unchecked
+ * `len` can pass `cap` and make the next `cap - len` remaining-space
+ * argument underflow to a huge size_t — a write past the buffer. With
+ * the clamp, a too-large record degrades to a truncated JSON file
+ * instead of memory corruption during boot.
+ */
+static int _cap_len(int len, size_t cap) {
+    return (len > (int)cap) ? (int)cap : len;
+}
+
+static void _save_crash_to_fs(const crash_record_t *rec) {
+    /* Lazy mount: the background loader may not have mounted yet —
+     * the RTT report above already carries everything, skip the file. */
+    if (!fs_manager_is_mounted()) {
+        printf("[crash_reporter] Filesystem not mounted yet, skipping %s\n",
+               CRASH_FILE_PATH);
+        return;
+    }
+
     /* Access the LittleFS instance from fs_port_rp2040.c */
     extern lfs_t g_lfs;
 
     /* Create /crash directory (ignore LFS_ERR_EXIST) */
     lfs_mkdir(&g_lfs, CRASH_DIR);
 
-    /* Format JSON manually (no cJSON needed for simple output) */
-    char json[256];
+    /* Format JSON manually (no cJSON needed for simple output).
+     * Static buffer: the log-tail hex strings alone are ~1.5KB. */
+    static char json[3072];
     int len = snprintf(json, sizeof(json),
         "{\n"
         "  \"magic\": \"0x%08lx\",\n"
@@ -109,8 +213,7 @@ static void _save_crash_to_fs(void) {
         "  \"xpsr\": \"0x%08lx\",\n"
         "  \"core_id\": %u,\n"
         "  \"task_number\": %u,\n"
-        "  \"version\": 1\n"
-        "}\n",
+        "  \"version\": 2",
         (unsigned long)s_crash_data.magic,
         (unsigned long)s_crash_data.pc,
         (unsigned long)s_crash_data.lr,
@@ -118,6 +221,41 @@ static void _save_crash_to_fs(void) {
         s_crash_data.core_id,
         s_crash_data.task_number);
 
+    if (rec != NULL) {
+        len = _cap_len(len + snprintf(json + len, sizeof(json) - (size_t)len,
+                        ",\n  \"tick\": %lu,\n  \"regs\": [",
+                        (unsigned long)rec->tick), sizeof(json));
+        for (unsigned i = 0; i < 8; i++) {
+            len = _cap_len(len + snprintf(json + len,
+                            sizeof(json) - (size_t)len,
+                            "%s\"0x%08lx\"", i ? ", " : "",
+                            (unsigned long)rec->regs[i]), sizeof(json));
+        }
+        len = _cap_len(len + snprintf(json + len, sizeof(json) - (size_t)len,
+                        "],\n  \"backtrace\": ["), sizeof(json));
+        unsigned bt_count = _rec_bt_count(rec);
+        for (unsigned i = 0; i < bt_count; i++) {
+            len = _cap_len(len + snprintf(json + len,
+                            sizeof(json) - (size_t)len,
+                            "%s\"0x%08lx\"", i ? ", " : "",
+                            (unsigned long)rec->backtrace[i]), sizeof(json));
+        }
+        len = _cap_len(len + snprintf(json + len, sizeof(json) - (size_t)len,
+                        "],\n  \"recent_logs\": {\n    \"core0\": \""),
+                        sizeof(json));
+        len = _append_hex(json, len, (int)sizeof(json),
+                          rec->log_bytes[0], _rec_log_len(rec, 0));
+        len = _cap_len(len + snprintf(json + len, sizeof(json) - (size_t)len,
+                        "\",\n    \"core1\": \""), sizeof(json));
+        len = _append_hex(json, len, (int)sizeof(json),
+                          rec->log_bytes[1], _rec_log_len(rec, 1));
+        len = _cap_len(len + snprintf(json + len, sizeof(json) - (size_t)len,
+                        "\"\n  }"), sizeof(json));
+    }
+
+    len = _cap_len(len + snprintf(json + len, sizeof(json) - (size_t)len,
+                    "\n}\n"), sizeof(json));
+
     /* Write to LittleFS (static buffer required with LFS_NO_MALLOC) */
     static uint8_t s_crash_file_buf[256];
     struct lfs_file_config file_cfg = { .buffer = s_crash_file_buf };
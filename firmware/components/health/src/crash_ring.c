@@ -0,0 +1,217 @@
+/**
+ * @file crash_ring.c
+ * @brief BB5: Flash-backed crash black-box — slot scan, fault-safe write.
+ *
+ * Boot (crash_ring_init, pre-scheduler): find the latest record by
+ * sequence number and make sure the NEXT slot is erased, so the fault
+ * path never erases. Erasing is only needed when the next slot starts
+ * a sector whose old records are the ring's oldest — 4 slots per
+ * sector, so one erase buys 4 crash-free writes.
+ *
+ * Fault (crash_ring_write): build the record in a static SRAM buffer
+ * with open-coded loops (no memcpy — it lives in flash), then one
+ * flash_range_program. Writer code is in SRAM like crash_handler_c.
+ */
+
+#include "crash_ring.h"
+#include "fs_config.h"
+#include "log_ring.h"
+#include "flash_safe.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/platform.h"          /* __no_inline_not_in_flash_func, XIP_BASE */
+#include "hardware/structs/sio.h"   /* sio_hw->cpuid */
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+
+/* Record must fit the slot and the slot must divide the sector. */
+_Static_assert(sizeof(crash_record_t) <= CRASH_RING_RECORD_SIZE,
+               "crash_record_t exceeds its flash slot");
+_Static_assert((FLASH_SECTOR_SIZE % CRASH_RING_RECORD_SIZE) == 0,
+               "slot size must divide the flash sector size");
+
+#define SLOTS_PER_SECTOR    (FLASH_SECTOR_SIZE / CRASH_RING_RECORD_SIZE)
+
+/* =========================================================================
+ * Module State
+ * ========================================================================= */
+
+/** Flash offset (from XIP_BASE) of the slot the next crash writes. */
+static uint32_t s_next_offset;
+
+/** Sequence number the next record gets. */
+static uint32_t s_next_seq;
+
+/** Latest valid record found at boot (XIP pointer), or NULL. */
+static const crash_record_t *s_latest;
+
+/** Ready flag — write is a no-op until init has prepared a slot. */
+static bool s_ready;
+
+/** SRAM staging buffer — record + pad programmed in one call. */
+static union {
+    crash_record_t rec;
+    uint8_t        raw[CRASH_RING_RECORD_SIZE];
+} s_staging;
+
+/* =========================================================================
+ * Helpers
+ * ========================================================================= */
+
+static const crash_record_t *_slot(unsigned index) {
+    return (const crash_record_t *)
+        (XIP_BASE + FS_CRASH_RING_OFFSET + index * CRASH_RING_RECORD_SIZE);
+}
+
+static bool _slot_blank(unsigned index) {
+    /* Erased NOR reads all-ones — the magic word is enough to check */
+    return _slot(index)->magic == 0xFFFFFFFFu;
+}
+
+/** flash_safe_op callback for the post-scheduler erase path. */
+static void _erase_cb(void *param) {
+    flash_range_erase((uint32_t)(uintptr_t)param, FLASH_SECTOR_SIZE);
+}
+
+static void _erase_slot_sector(uint32_t flash_offset) {
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        /* Pre-scheduler: Core 1 is not running, no lockout needed */
+        flash_range_erase(flash_offset, FLASH_SECTOR_SIZE);
+    } else {
+        /* Deferred init (fast-boot profile): full dual-core lockout */
+        flash_safe_op(_erase_cb, (void *)(uintptr_t)flash_offset);
+    }
+}
+
+/* =========================================================================
+ * Init — boot-time slot scan and pre-erase
+ * ========================================================================= */
+
+void crash_ring_init(void) {
+    uint32_t max_seq = 0;
+    int latest = -1;
+
+    for (unsigned i = 0; i < CRASH_RING_SLOT_COUNT; i++) {
+        const crash_record_t *rec = _slot(i);
+        if (rec->magic == CRASH_RING_MAGIC && rec->seq > max_seq) {
+            max_seq = rec->seq;
+            latest = (int)i;
+        }
+    }
+
+    s_latest = (latest >= 0) ? _slot((unsigned)latest) : NULL;
+    s_next_seq = max_seq + 1;
+
+    unsigned next = (latest >= 0)
+                  ? ((unsigned)latest + 1) % CRASH_RING_SLOT_COUNT
+                  : 0;
+
+    if (!_slot_blank(next)) {
+        /* Occupied next slot means its sector holds the ring's oldest
+         * records. If it isn't sector-aligned the ring is inconsistent
+         * (partial write, old layout) — skip to the next sector rather
+         * than erase the sector holding the latest record. */
+        if (next % SLOTS_PER_SECTOR != 0) {
+            next = ((next / SLOTS_PER_SECTOR) + 1)
+                 % (CRASH_RING_SLOT_COUNT / SLOTS_PER_SECTOR)
+                 * SLOTS_PER_SECTOR;
+        }
+        _erase_slot_sector(FS_CRASH_RING_OFFSET
+                           + next * CRASH_RING_RECORD_SIZE);
+        printf("[crash_ring] Erased sector for slot %u\n", next);
+    }
+
+    s_next_offset = FS_CRASH_RING_OFFSET + next * CRASH_RING_RECORD_SIZE;
+    s_ready = true;
+
+    printf("[crash_ring] Ready: %d slots @ 0x%lx, next=%u seq=%lu\n",
+           CRASH_RING_SLOT_COUNT, (unsigned long)FS_CRASH_RING_OFFSET,
+           next, (unsigned long)s_next_seq);
+}
+
+/* =========================================================================
+ * Fault-context writer
+ * ========================================================================= */
+
+/**
+ * @brief Scan up the faulting stack for plausible code addresses.
+ *
+ * A word is a candidate return address if it is odd (Thumb bit) and
+ * falls inside the XIP text region. Crude but needs no unwind tables —
+ * good enough to name the call chain in a postmortem.
+ */
+static unsigned __no_inline_not_in_flash_func(_scan_backtrace)(
+        const uint32_t *sp, uint32_t *out, unsigned max) {
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < 256 && count < max; i++, sp++) {
+        /* Stay inside RP2040 SRAM (264KB at 0x20000000) */
+        uint32_t addr = (uint32_t)sp;
+        if (addr < 0x20000000u || addr >= 0x20042000u) break;
+
+        uint32_t v = *sp;
+        if ((v & 1u) && v >= (XIP_BASE + 0x100u)
+                     && v < (XIP_BASE + FS_FLASH_TOTAL_SIZE)) {
+            out[count++] = v;
+        }
+    }
+    return count;
+}
+
+void __no_inline_not_in_flash_func(crash_ring_write)(
+        uint32_t reason, const uint32_t *stack_frame) {
+    if (!s_ready) return;
+    s_ready = false;  /* One record per boot — slot is program-once */
+
+    crash_record_t *rec = &s_staging.rec;
+
+    /* Pad bytes program as 0xFF (NOP on NOR flash) */
+    for (unsigned i = 0; i < CRASH_RING_RECORD_SIZE; i++) {
+        s_staging.raw[i] = 0xFF;
+    }
+
+    rec->magic   = CRASH_RING_MAGIC;
+    rec->seq     = s_next_seq;
+    rec->reason  = reason;
+    rec->tick    = (uint32_t)xTaskGetTickCount();
+    rec->core_id = (uint8_t)sio_hw->cpuid;
+
+    rec->task_number = 0;
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    if (current != NULL) {
+        rec->task_number = (uint16_t)uxTaskGetTaskNumber(current);
+    }
+
+    for (unsigned i = 0; i < 8; i++) {
+        rec->regs[i] = stack_frame ? stack_frame[i] : 0;
+    }
+
+    /* Backtrace: scan above the exception frame, or from our own
+     * locals when called from a hook (no frame available). */
+    const uint32_t *scan_base = stack_frame ? stack_frame + 8
+                                            : (const uint32_t *)&current;
+    rec->bt_count = (uint8_t)_scan_backtrace(scan_base, rec->backtrace,
+                                             CRASH_RING_BT_MAX);
+
+    /* Tail of both cores' log rings — raw bytes, host resyncs framing */
+    for (unsigned core = 0; core < 2; core++) {
+        rec->log_len[core] = (uint16_t)log_ring_copy_recent(
+            core, rec->log_bytes[core], CRASH_RING_LOG_BYTES);
+    }
+
+    /* Single bounded program into the pre-erased slot. Already in
+     * exception context with IRQs masked on HardFault; mask explicitly
+     * for the hook paths. */
+    uint32_t save = save_and_disable_interrupts();
+    flash_range_program(s_next_offset, s_staging.raw, CRASH_RING_RECORD_SIZE);
+    restore_interrupts(save);
+}
+
+/* =========================================================================
+ * Boot-time reader
+ * ========================================================================= */
+
+const crash_record_t *crash_ring_latest(void) {
+    return s_latest;
+}
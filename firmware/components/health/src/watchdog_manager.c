@@ -6,6 +6,9 @@
  * A high-priority monitor task waits for all bits, then feeds the HW watchdog.
  * If any task misses its check-in, the monitor identifies the guilty task(s)
  * and lets the hardware watchdog reset the system.
+ *
+ * High-rate loops use the lock-free fast slots instead (flag bytes the
+ * monitor polls and clears) — see watchdog_manager_checkin_fast().
  */
 
 #include "watchdog_manager.h"
@@ -25,6 +28,12 @@ static EventBits_t s_registered_bits = 0;
 static uint32_t s_hw_timeout_ms = 8000;
 static bool s_hw_wdt_enabled = false;
 
+/* Fast (lock-free) check-in slots — flag bytes set by hot tasks.
+ * Non-static: watchdog_manager_checkin_fast() inlines the store. */
+volatile uint8_t g_wdg_fast_flags[WDG_FAST_MAX_SLOTS];
+static const char *s_fast_names[WDG_FAST_MAX_SLOTS];
+static int s_fast_count = 0;
+
 /* =========================================================================
  * Public API
  * ========================================================================= */
@@ -48,6 +57,19 @@ void watchdog_manager_checkin(EventBits_t task_bit) {
     }
 }
 
+int watchdog_manager_register_fast(const char *name) {
+    if (s_fast_count >= WDG_FAST_MAX_SLOTS) {
+        printf("[watchdog] WARNING: No fast slots left for '%s'\n", name);
+        return -1;
+    }
+
+    int slot = s_fast_count++;
+    s_fast_names[slot] = name;
+    g_wdg_fast_flags[slot] = 0;
+    printf("[watchdog] Registered fast slot %d: '%s'\n", slot, name);
+    return slot;
+}
+
 /* =========================================================================
  * Monitor Task — Core Watchdog Loop
  * ========================================================================= */
@@ -83,14 +105,38 @@ static void _watchdog_monitor_task(void *params) {
             pdMS_TO_TICKS(WDG_CHECK_PERIOD_MS)
         );
 
-        if ((result & s_registered_bits) == s_registered_bits) {
+        /*
+         * Poll and clear the fast slots. Fast tasks run at loop rates
+         * far above 1/WDG_CHECK_PERIOD_MS, so by the time the Event
+         * Group wait returns (early or on timeout) a healthy fast task
+         * has long since set its flag. The read-then-clear is safe
+         * without a lock: we only clear a flag we observed set, and a
+         * racing store just re-proves liveness for the next period.
+         */
+        uint32_t fast_missing = 0;
+        for (int i = 0; i < s_fast_count; i++) {
+            if (g_wdg_fast_flags[i]) {
+                g_wdg_fast_flags[i] = 0;
+            } else {
+                fast_missing |= (1u << i);
+            }
+        }
+
+        if ((result & s_registered_bits) == s_registered_bits &&
+            fast_missing == 0) {
             /* All tasks checked in — feed the hardware watchdog */
             watchdog_hal_kick();
         } else {
             /* Timeout — identify guilty task(s) */
             EventBits_t missing = s_registered_bits & ~result;
-            printf("[watchdog] TIMEOUT! Missing bits: 0x%lx\n",
-                   (unsigned long)missing);
+            printf("[watchdog] TIMEOUT! Missing bits: 0x%lx, fast: 0x%lx\n",
+                   (unsigned long)missing, (unsigned long)fast_missing);
+            for (int i = 0; i < s_fast_count; i++) {
+                if (fast_missing & (1u << i)) {
+                    printf("[watchdog]   fast slot %d '%s' missed check-in\n",
+                           i, s_fast_names[i]);
+                }
+            }
 
             /*
              * Write guilty bits to scratch[3] for post-mortem analysis.
@@ -98,12 +144,14 @@ static void _watchdog_monitor_task(void *params) {
              * crash reporter can distinguish watchdog timeout from HardFault.
              *
              * scratch[0] = 0xDEADB10C ("dead block" = watchdog timeout)
-             * scratch[1] = missing bits
+             * scratch[1] = missing bits | fast_missing << 24
+             *              (Event Groups only use bits 0-23, so the
+             *               fast-slot mask rides in the top byte)
              * scratch[2] = tick count at timeout
              * scratch[3] = s_registered_bits (for reference)
              */
             watchdog_hal_set_scratch(0, 0xDEADB10Cu);
-            watchdog_hal_set_scratch(1, missing);
+            watchdog_hal_set_scratch(1, (uint32_t)missing | (fast_missing << 24));
             watchdog_hal_set_scratch(2, (uint32_t)xTaskGetTickCount());
             watchdog_hal_set_scratch(3, s_registered_bits);
 
@@ -124,7 +172,7 @@ static void _watchdog_monitor_task(void *params) {
  * ========================================================================= */
 
 void watchdog_manager_start(void) {
-    if (s_registered_bits == 0) {
+    if (s_registered_bits == 0 && s_fast_count == 0) {
         printf("[watchdog] WARNING: No tasks registered, skipping monitor\n");
         return;
     }
@@ -141,7 +189,7 @@ void watchdog_manager_start(void) {
     if (ret != pdPASS) {
         printf("[watchdog] FATAL: Failed to create monitor task\n");
     } else {
-        printf("[watchdog] Monitor task created, checking %d task(s)\n",
-               __builtin_popcount((unsigned)s_registered_bits));
+        printf("[watchdog] Monitor task created, checking %d task(s) + %d fast\n",
+               __builtin_popcount((unsigned)s_registered_bits), s_fast_count);
     }
 }
@@ -0,0 +1,56 @@
+/**
+ * @file boot_profile.h
+ * @brief Boot-phase profiler — where does the cold start go?
+ *
+ * main() runs the init phases strictly serially; this records a
+ * hardware-timer timestamp (TIMERAWL, 1MHz) at each phase boundary
+ * into a static table. Once the supervisor task starts, the table is
+ * emitted exactly once as a TELEMETRY_PKT_BOOT_TIMELINE packet on RTT
+ * Channel 2, giving per-phase durations from power-on.
+ *
+ * Usage in main():
+ *   system_init();
+ *   boot_profile_mark("sysinit");
+ *   ai_log_init();
+ *   boot_profile_mark("ai_log");
+ *   ...
+ *
+ * Marks are pre-scheduler and single-core (Core 1 only launches with
+ * the scheduler), so recording needs no locking. Names travel in the
+ * packet as fixed 8-byte fields — no token database required on the
+ * host side.
+ */
+
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+
+/** Maximum recorded phase boundaries. Extra marks are dropped
+ *  (counted in the packet's dropped field). */
+#define BOOT_PROFILE_MAX_MARKS      16
+
+/** Bytes of the phase name carried per entry (truncated, not
+ *  necessarily NUL-terminated on the wire). */
+#define BOOT_PROFILE_NAME_LEN       8
+
+/**
+ * @brief Record a phase boundary: name + microsecond timestamp.
+ *
+ * Call from main() after each init phase completes. The timestamp is
+ * TIMERAWL, i.e. microseconds since timer start (effectively power-on).
+ *
+ * @param name  Short phase name (≤ 8 chars survive; use a literal)
+ */
+void boot_profile_mark(const char *name);
+
+/**
+ * @brief Emit the boot timeline packet — one-shot.
+ *
+ * Called by the supervisor task on its first cycle. Subsequent calls
+ * are no-ops, so the timeline appears exactly once per boot in the
+ * telemetry stream.
+ */
+void boot_profile_emit(void);
+
+#endif /* BOOT_PROFILE_H */
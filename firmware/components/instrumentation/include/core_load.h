@@ -0,0 +1,73 @@
+/**
+ * @file core_load.h
+ * @brief Per-core interrupt-time accounting for the core-load packet.
+ *
+ * The TELEMETRY_PKT_CORE_LOAD packet reports, per window: per-core idle
+ * percentage (from the idle tasks' runtime counters), context-switch
+ * counts (task_trace.h), flash lockout count/time (flash_safe.h — the
+ * only events that freeze BOTH cores), and the interrupt time tracked
+ * here.
+ *
+ * Any ISR that wants its time attributed calls the bracket pair:
+ *
+ *   void my_irq_handler(void) {
+ *       uint32_t t0 = core_load_irq_enter();
+ *       ... handler body ...
+ *       core_load_irq_exit(t0);
+ *   }
+ *
+ * Cost is two TIMERAWL reads and two word increments, safe at any IRQ
+ * priority: the RP2040 timer has no latching side effects, and the
+ * accumulators are per-core so the only writer of each word is that
+ * core (an interrupting higher-priority ISR nests its own bracket,
+ * which double-counts the nested time — acceptable for load trending).
+ *
+ * Nothing in the tree registers raw ISRs today (GPIO events arrive via
+ * hardware_alarm callbacks inside the SDK); the brackets exist so new
+ * handlers report from day one and the packet layout never changes.
+ */
+
+#ifndef CORE_LOAD_H
+#define CORE_LOAD_H
+
+#include <stdint.h>
+#include "hardware/timer.h"     /* timer_hw->timerawl */
+#include "pico/platform.h"      /* get_core_num() */
+
+/* Accumulators — one writer each (the owning core's ISRs), read
+ * lock-free by the supervisor. Defined in core_load.c. */
+extern volatile uint32_t _core_load_irq_us[2];
+extern volatile uint32_t _core_load_irq_count[2];
+
+/**
+ * @brief Mark ISR entry. Returns the entry timestamp to pass to
+ *        core_load_irq_exit().
+ */
+static inline uint32_t core_load_irq_enter(void) {
+    return timer_hw->timerawl;
+}
+
+/**
+ * @brief Mark ISR exit and attribute the elapsed time to this core.
+ *
+ * @param enter_ts  Value returned by core_load_irq_enter()
+ */
+static inline void core_load_irq_exit(uint32_t enter_ts) {
+    unsigned core = get_core_num();
+    _core_load_irq_us[core] += timer_hw->timerawl - enter_ts;
+    _core_load_irq_count[core]++;
+}
+
+/**
+ * @brief Cumulative microseconds spent in bracketed ISRs on one core.
+ * @param core  0 or 1 (out of range returns 0)
+ */
+uint32_t core_load_irq_time_us(unsigned core);
+
+/**
+ * @brief Cumulative bracketed ISR invocations on one core.
+ * @param core  0 or 1 (out of range returns 0)
+ */
+uint32_t core_load_irq_count(unsigned core);
+
+#endif /* CORE_LOAD_H */
@@ -0,0 +1,80 @@
+/**
+ * @file sched_stats.h
+ * @brief Wrap-free 64-bit runtime + scheduling-latency accounting.
+ *
+ * The kernel's ulRunTimeCounter is 32 bits of 1MHz TIMERAWL — it wraps
+ * after ~71 minutes, which silently corrupts CPU% exactly when a soak
+ * run gets interesting. This layer maintains its own per-task counters
+ * from the context-switch trace hooks (a few cycles on top of the
+ * task_trace producer, same kernel context):
+ *
+ *   - 64-bit cumulative runtime (µs) — wraps after ~584,000 years
+ *   - ready→running latency: cumulative sum + count, rolling max
+ *   - preemption count: switch-ins where the task had stayed ready
+ *     since its last switch-out (no unblock event in between), i.e.
+ *     it lost the CPU to a higher-priority task rather than blocking
+ *
+ * Tasks are indexed by their kernel-assigned TCB number (monotonic,
+ * never reused) — NOT modulo-folded, so two tasks can never alias.
+ * Task numbers at or beyond SCHED_STATS_MAX_TASKS are ignored; with
+ * this firmware's static task set the numbers stay single-digit.
+ *
+ * Consumers: supervisor_task.c reads the counters each sampling window
+ * and ships deltas in the extended task_entry_t.
+ */
+
+#ifndef SCHED_STATS_H
+#define SCHED_STATS_H
+
+#include <stdint.h>
+
+/** Slot count — must cover every TCB number the firmware ever assigns.
+ *  Matches SUPERVISOR_MAX_TASKS so every reported task has a slot. */
+#define SCHED_STATS_MAX_TASKS       32
+
+/**
+ * @brief Hook: task switched in (dir_in=1) or out (dir_in=0).
+ *
+ * Called from traceTASK_SWITCHED_IN/OUT in kernel context with
+ * interrupts masked on the switching core. Not for application use.
+ *
+ * @param task_number  Kernel TCB number (uxTCBNumber)
+ */
+void _sched_stats_switch(unsigned dir_in, unsigned task_number);
+
+/**
+ * @brief Hook: task moved to the ready list (unblocked / created).
+ *
+ * Called from traceMOVED_TASK_TO_READY_STATE. Timestamps the ready
+ * transition so the next switch-in yields the wakeup latency.
+ */
+void _sched_stats_ready(unsigned task_number);
+
+/**
+ * @brief Cumulative runtime of a task in µs — 64-bit, wrap-free.
+ *
+ * Seqlock-protected against torn reads of the 64-bit value while the
+ * task's own core is updating it. Returns 0 for out-of-range numbers.
+ */
+uint64_t sched_stats_runtime_us(unsigned task_number);
+
+/** Cumulative ready→running latency sum (µs). Pair with
+ *  sched_stats_latency_count() and keep per-window prevs for a mean. */
+uint32_t sched_stats_latency_sum_us(unsigned task_number);
+
+/** Cumulative count of measured ready→running transitions. */
+uint32_t sched_stats_latency_count(unsigned task_number);
+
+/**
+ * @brief Read AND reset the rolling ready→running latency max (µs).
+ *
+ * A max cannot be delta'd, so the reader claims it per window. A hook
+ * racing between the read and the clear can lose one sample into the
+ * following window — harmless for a per-window diagnostic.
+ */
+uint32_t sched_stats_latency_max_take(unsigned task_number);
+
+/** Cumulative preemption count (lost the CPU while still ready). */
+uint32_t sched_stats_preempt_count(unsigned task_number);
+
+#endif /* SCHED_STATS_H */
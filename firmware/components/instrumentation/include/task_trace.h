@@ -0,0 +1,119 @@
+/**
+ * @file task_trace.h
+ * @brief Context-switch trace stream — public API.
+ *
+ * Records every traceTASK_SWITCHED_IN/OUT event into a per-core SPSC
+ * ring and streams them to SEGGER RTT Channel 3, filling the gap
+ * between 500ms supervisor samples: when a task overruns, the stream
+ * shows exactly what preempted it and for how long.
+ *
+ * RTT Channel Allocation:
+ *   Channel 0: Text stdio, Channel 1: tokenized logs (BB2),
+ *   Channel 2: telemetry vitals (BB4), Channel 3: task trace.
+ *
+ * Event encoding (per core, self-delimiting):
+ *   [dir:1 bit (bit7)][task_number:7 bits] [delta_us:varint 1-5]
+ *   dir=1: switched in, dir=0: switched out. delta_us is the TIMERAWL
+ *   microsecond delta since the previous event on the SAME core —
+ *   typically 1-2 bytes, so a switch pair costs ~4-6 bytes.
+ *
+ * Wire format (flusher → Channel 3, one block per drain per core):
+ *   [0xC0|core:1][seq:1][payload_len:2][last_ts:4][events...]
+ *   last_ts is the absolute TIMERAWL timestamp of the LAST event in
+ *   the block; the host anchors the delta chain to it, so a dropped
+ *   block (RTT full) costs that block only — the next block re-anchors.
+ *   seq is per-core and lets the decoder report the gap.
+ *
+ * The hook path is a few dozen cycles: one timer read, a bounds check,
+ * 2-6 ring bytes, no locks (the scheduler is the only producer on its
+ * core, the flusher the only consumer). Compiled out entirely in
+ * production builds via AI_TASK_TRACE_ENABLED.
+ */
+
+#ifndef TASK_TRACE_H
+#define TASK_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Configuration
+ * ========================================================================= */
+
+/** RTT channel for the binary switch-event stream. */
+#define TASK_TRACE_RTT_CHANNEL      3
+
+/** RTT up-buffer size (bytes). A busy core switches ~2k times/second
+ *  under load → ~10KB/s of events; 2KB gives the host ~200ms of slack
+ *  between drains before whole blocks start dropping. */
+#define TASK_TRACE_RTT_BUFFER_SIZE  2048
+
+/** Per-core event ring capacity in bytes. Must be a power of two.
+ *  4KB ≈ 800+ events of headroom between flushes. */
+#define TASK_TRACE_RING_SIZE        4096
+
+/** Flusher drain period — same cadence as the log flusher. */
+#define TASK_TRACE_FLUSH_PERIOD_MS  10
+
+/** Flusher task priority/stack — just above idle, drain + RTT write. */
+#define TASK_TRACE_FLUSHER_PRIORITY (tskIDLE_PRIORITY + 1)
+#define TASK_TRACE_FLUSHER_STACK_SIZE (configMINIMAL_STACK_SIZE)
+
+/** Largest single wire block (header + whole events). */
+#define TASK_TRACE_MAX_BLOCK        512
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Initialize the trace rings and RTT Channel 3.
+ *
+ * ⚠️ Call from main() before the scheduler starts — the hooks fire on
+ * the very first context switch and drop events until this has run.
+ */
+void task_trace_init(void);
+
+/**
+ * @brief Switch-event producer — invoked by the traceTASK_SWITCHED_IN
+ *        and traceTASK_SWITCHED_OUT macros in FreeRTOSConfig.h.
+ * @note Do not call directly.
+ *
+ * @param dir_in       1 = switched in, 0 = switched out
+ * @param task_number  uxTaskNumber of the task (0-127 reportable)
+ */
+void _task_trace_switch(unsigned dir_in, unsigned task_number);
+
+/**
+ * @brief Drain both per-core rings to RTT Channel 3.
+ * @return Bytes written to RTT
+ */
+unsigned task_trace_flush(void);
+
+/**
+ * @brief Events dropped because a ring was full (both cores).
+ */
+uint32_t task_trace_dropped(void);
+
+/**
+ * @brief Cumulative switched-in events on one core since boot.
+ *
+ * Counted in the hook even when the trace ring is full, so the
+ * core-load telemetry packet sees every switch. Returns 0 for an
+ * out-of-range core.
+ *
+ * @param core  0 or 1
+ */
+uint32_t task_trace_switch_count(unsigned core);
+
+/**
+ * @brief Start the low-priority flusher task.
+ *
+ * Call from main() before vTaskStartScheduler(). Until the task runs,
+ * events accumulate in the rings (4KB per core of headroom).
+ *
+ * @return true if the task was created
+ */
+bool task_trace_start_flusher(void);
+
+#endif /* TASK_TRACE_H */
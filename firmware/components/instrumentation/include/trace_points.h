@@ -0,0 +1,106 @@
+/**
+ * @file trace_points.h
+ * @brief Hot-path latency tracepoints — public API.
+ *
+ * Measures critical-section lengths, ISR entry-to-exit times, and other
+ * short code paths that the 500ms supervisor CPU% cannot see.
+ *
+ * Usage:
+ *   TRACE_ENTER(TRACE_ID_FLASH_OP);
+ *   ... code under measurement ...
+ *   TRACE_EXIT(TRACE_ID_FLASH_OP);
+ *
+ * Each tracepoint accumulates count/min/max/sum per core from the
+ * RP2040 1MHz hardware timer (TIMERAWL — no latching side effects, safe
+ * from both cores and ISRs). The supervisor periodically emits the
+ * per-window statistics as a TELEMETRY_PKT_TRACE_STATS packet on RTT
+ * Channel 2 and resets the window.
+ *
+ * When AI_TRACE_ENABLED is 0 (the BUILD_PRODUCTION default) the macros
+ * expand to nothing — zero code, zero data — so tracepoints can stay in
+ * the source permanently.
+ *
+ * Constraints:
+ *   - ENTER/EXIT pairs must not nest for the same id on the same core.
+ *   - Safe from task and ISR context (per-core stats, masked-IRQ update).
+ */
+
+#ifndef TRACE_POINTS_H
+#define TRACE_POINTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Configuration
+ * ========================================================================= */
+
+/** Compile tracepoints in. Default: on for development, off when the
+ *  production build strips observability. Override per-target via
+ *  target_compile_definitions(... AI_TRACE_ENABLED=1). */
+#ifndef AI_TRACE_ENABLED
+#ifdef BUILD_PRODUCTION
+#define AI_TRACE_ENABLED    0
+#else
+#define AI_TRACE_ENABLED    1
+#endif
+#endif
+
+/* =========================================================================
+ * Tracepoint IDs — add new points here (keep below AI_TRACE_MAX_POINTS)
+ * ========================================================================= */
+
+#define TRACE_ID_LOG_WRITE      0   /**< _ai_log_write() end to end */
+#define TRACE_ID_FLASH_OP       1   /**< flash_safe_op() stall window */
+#define TRACE_ID_VITALS_BUILD   2   /**< Supervisor packet build */
+#define TRACE_ID_USER0          3   /**< Free for ad-hoc measurements */
+#define TRACE_ID_USER1          4
+#define TRACE_ID_USER2          5
+
+/** Upper bound on tracepoint IDs — sizes the per-core stat arrays. */
+#define AI_TRACE_MAX_POINTS     8
+
+/* =========================================================================
+ * Per-Tracepoint Window Statistics
+ * ========================================================================= */
+
+typedef struct {
+    uint32_t count;         /**< Completed ENTER/EXIT pairs this window */
+    uint32_t min_us;        /**< Shortest interval (μs) */
+    uint32_t max_us;        /**< Longest interval (μs) */
+    uint64_t sum_us;        /**< Sum for mean calculation */
+    uint32_t enter_ts;      /**< TIMERAWL at last ENTER (0 = closed) */
+} trace_stats_t;
+
+/* =========================================================================
+ * Core Functions (implemented in trace_points.c)
+ * ========================================================================= */
+
+/** @brief Internal: record tracepoint entry. Use TRACE_ENTER(). */
+void _trace_enter(uint8_t id);
+
+/** @brief Internal: record tracepoint exit. Use TRACE_EXIT(). */
+void _trace_exit(uint8_t id);
+
+/**
+ * @brief Emit per-core trace statistics as a telemetry packet and
+ *        reset the measurement window.
+ *
+ * Called by the supervisor task each sampling cycle. Tracepoints with
+ * zero completions in the window are omitted from the packet.
+ */
+void trace_points_emit(void);
+
+/* =========================================================================
+ * Public Macros
+ * ========================================================================= */
+
+#if AI_TRACE_ENABLED
+#define TRACE_ENTER(id)     _trace_enter(id)
+#define TRACE_EXIT(id)      _trace_exit(id)
+#else
+#define TRACE_ENTER(id)     do { } while (0)
+#define TRACE_EXIT(id)      do { } while (0)
+#endif
+
+#endif /* TRACE_POINTS_H */
@@ -0,0 +1,78 @@
+/**
+ * @file boot_profile.c
+ * @brief Boot-phase profiler — static mark table + one-shot emit.
+ *
+ * Packet layout (TELEMETRY_PKT_BOOT_TIMELINE):
+ *   [type:1][count:1][dropped:1]
+ *   per entry: [name:8][timestamp_us:4]
+ *
+ * Timestamps are absolute TIMERAWL values; the host computes phase
+ * durations as successive deltas (first entry ≈ time from timer start
+ * to the end of the first phase).
+ */
+
+#include "boot_profile.h"
+#include "telemetry.h"          /* TELEMETRY_PKT_BOOT_TIMELINE */
+#include "hardware/timer.h"     /* timer_hw */
+#include <stdbool.h>
+#include <string.h>
+
+/* Forward declaration — defined in telemetry_driver.c */
+extern unsigned telemetry_write_packet(const void *data, unsigned length);
+
+/* =========================================================================
+ * Mark Table
+ * ========================================================================= */
+
+typedef struct {
+    char     name[BOOT_PROFILE_NAME_LEN];
+    uint32_t timestamp_us;
+} boot_mark_t;
+
+static boot_mark_t s_marks[BOOT_PROFILE_MAX_MARKS];
+static uint8_t s_mark_count;
+static uint8_t s_dropped;
+static bool s_emitted;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+void boot_profile_mark(const char *name) {
+    uint32_t now = timer_hw->timerawl;
+
+    if (s_mark_count >= BOOT_PROFILE_MAX_MARKS) {
+        s_dropped++;
+        return;
+    }
+
+    boot_mark_t *mark = &s_marks[s_mark_count++];
+    mark->timestamp_us = now;
+
+    /* Fixed-width copy, space-padded — no strlen surprises on the wire */
+    memset(mark->name, ' ', BOOT_PROFILE_NAME_LEN);
+    for (unsigned i = 0; i < BOOT_PROFILE_NAME_LEN && name[i] != '\0'; i++) {
+        mark->name[i] = name[i];
+    }
+}
+
+void boot_profile_emit(void) {
+    if (s_emitted || s_mark_count == 0) return;
+    s_emitted = true;
+
+    uint8_t packet[3 + BOOT_PROFILE_MAX_MARKS * (BOOT_PROFILE_NAME_LEN + 4)];
+    unsigned pos = 0;
+
+    packet[pos++] = TELEMETRY_PKT_BOOT_TIMELINE;
+    packet[pos++] = s_mark_count;
+    packet[pos++] = s_dropped;
+
+    for (unsigned i = 0; i < s_mark_count; i++) {
+        memcpy(&packet[pos], s_marks[i].name, BOOT_PROFILE_NAME_LEN);
+        pos += BOOT_PROFILE_NAME_LEN;
+        memcpy(&packet[pos], &s_marks[i].timestamp_us, 4);
+        pos += 4;
+    }
+
+    telemetry_write_packet(packet, pos);
+}
@@ -0,0 +1,20 @@
+/**
+ * @file core_load.c
+ * @brief Per-core interrupt-time accumulators — see core_load.h.
+ *
+ * The bracket inlines in the header do the actual timing; this file
+ * only owns the storage and the supervisor-facing getters.
+ */
+
+#include "core_load.h"
+
+volatile uint32_t _core_load_irq_us[2];
+volatile uint32_t _core_load_irq_count[2];
+
+uint32_t core_load_irq_time_us(unsigned core) {
+    return (core < 2) ? _core_load_irq_us[core] : 0;
+}
+
+uint32_t core_load_irq_count(unsigned core) {
+    return (core < 2) ? _core_load_irq_count[core] : 0;
+}
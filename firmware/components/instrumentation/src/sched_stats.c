@@ -0,0 +1,136 @@
+/**
+ * @file sched_stats.c
+ * @brief Wrap-free 64-bit runtime + scheduling-latency accounting.
+ *
+ * Producer side runs inside the context-switch path (see task_trace.c
+ * for the execution-context argument: kernel context, interrupts
+ * masked on the switching core, the task's switch events are
+ * serialized because a task runs on one core at a time). Cost per
+ * hook: one TIMERAWL read and a handful of word stores.
+ *
+ * The only multi-word value is the 64-bit runtime, guarded by a
+ * per-slot sequence counter (odd = write in progress) so the
+ * supervisor on the other core can never see a torn half-updated
+ * value — the exact failure mode of the wrapping 32-bit counter this
+ * module replaces. All other counters are single aligned words,
+ * atomic on M0+ as everywhere else in this codebase.
+ */
+
+#include "sched_stats.h"
+#include "hardware/timer.h"     /* timer_hw->timerawl */
+#include <string.h>
+
+/* =========================================================================
+ * Per-Task Slots
+ * ========================================================================= */
+
+typedef struct {
+    uint64_t runtime_us;            /* Guarded by seq below */
+    volatile uint32_t seq;          /* Seqlock: odd while updating */
+    uint32_t switched_in_ts;        /* TIMERAWL at last switch-in */
+    uint32_t switched_out_ts;       /* TIMERAWL at last switch-out */
+    uint32_t ready_ts;              /* TIMERAWL of pending ready event */
+    uint8_t  ready_pending;         /* Ready event awaiting switch-in */
+    uint8_t  seen_out;              /* Has been switched out at least once */
+    volatile uint32_t lat_sum_us;   /* Cumulative ready→running latency */
+    volatile uint32_t lat_count;    /* Cumulative measured transitions */
+    volatile uint32_t lat_max_us;   /* Rolling max — cleared by reader */
+    volatile uint32_t preempt_count; /* Cumulative preemptions */
+} sched_slot_t;
+
+static sched_slot_t s_slots[SCHED_STATS_MAX_TASKS];
+
+/* =========================================================================
+ * Hooks — context-switch path
+ * ========================================================================= */
+
+void _sched_stats_switch(unsigned dir_in, unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return;
+    sched_slot_t *slot = &s_slots[task_number];
+    uint32_t now = timer_hw->timerawl;
+
+    if (dir_in) {
+        uint32_t latency;
+        if (slot->ready_pending) {
+            /* Normal wakeup: ready event seen, measure ready→running */
+            latency = now - slot->ready_ts;
+            slot->ready_pending = 0;
+        } else if (slot->seen_out) {
+            /* No unblock since the last switch-out — the task stayed
+             * ready the whole time, i.e. it was preempted. Latency is
+             * the time it spent waiting to get the CPU back. */
+            latency = now - slot->switched_out_ts;
+            slot->preempt_count++;
+        } else {
+            /* First ever switch-in without a ready event (task existed
+             * before the hooks armed) — nothing to measure. */
+            slot->switched_in_ts = now;
+            return;
+        }
+
+        slot->lat_sum_us += latency;
+        slot->lat_count++;
+        if (latency > slot->lat_max_us) slot->lat_max_us = latency;
+        slot->switched_in_ts = now;
+    } else {
+        /* Accumulate the slice just ended under the seqlock */
+        slot->seq++;                            /* Odd: write open */
+        __asm volatile("" ::: "memory");
+        slot->runtime_us += (uint64_t)(now - slot->switched_in_ts);
+        __asm volatile("" ::: "memory");
+        slot->seq++;                            /* Even: write closed */
+
+        slot->switched_out_ts = now;
+        slot->seen_out = 1;
+    }
+}
+
+void _sched_stats_ready(unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return;
+    sched_slot_t *slot = &s_slots[task_number];
+    slot->ready_ts = timer_hw->timerawl;
+    slot->ready_pending = 1;
+}
+
+/* =========================================================================
+ * Readers — supervisor sampling window
+ * ========================================================================= */
+
+uint64_t sched_stats_runtime_us(unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return 0;
+    sched_slot_t *slot = &s_slots[task_number];
+
+    uint64_t value;
+    uint32_t seq_before, seq_after;
+    do {
+        seq_before = slot->seq;
+        __asm volatile("" ::: "memory");
+        value = slot->runtime_us;
+        __asm volatile("" ::: "memory");
+        seq_after = slot->seq;
+    } while ((seq_before & 1u) || seq_before != seq_after);
+
+    return value;
+}
+
+uint32_t sched_stats_latency_sum_us(unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return 0;
+    return s_slots[task_number].lat_sum_us;
+}
+
+uint32_t sched_stats_latency_count(unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return 0;
+    return s_slots[task_number].lat_count;
+}
+
+uint32_t sched_stats_latency_max_take(unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return 0;
+    uint32_t max = s_slots[task_number].lat_max_us;
+    s_slots[task_number].lat_max_us = 0;
+    return max;
+}
+
+uint32_t sched_stats_preempt_count(unsigned task_number) {
+    if (task_number >= SCHED_STATS_MAX_TASKS) return 0;
+    return s_slots[task_number].preempt_count;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file task_trace.c
+ * @brief Context-switch trace stream — per-core rings + flusher.
+ *
+ * Producer (scheduler, inside the context-switch path):
+ *   The trace hooks run in kernel context with interrupts masked on the
+ *   switching core, and only that core's scheduler writes its ring —
+ *   true SPSC, so the producer takes NO lock and masks nothing itself.
+ *   Cost: one TIMERAWL read, a bounds check, 2-6 ring bytes, one
+ *   published index store.
+ *
+ * Consumer (flusher task, any core):
+ *   Walks whole events (they are self-delimiting: header byte + varint)
+ *   into a staging block and writes it to RTT Channel 3 with a per-core
+ *   header carrying a sequence number and an absolute re-anchor
+ *   timestamp — see task_trace.h for the wire format.
+ */
+
+#include "task_trace.h"
+#include "SEGGER_RTT.h"
+#include "hardware/timer.h"     /* timer_hw->timerawl */
+#include "pico/platform.h"      /* get_core_num() */
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * Per-Core Ring State
+ * ========================================================================= */
+
+#if (TASK_TRACE_RING_SIZE & (TASK_TRACE_RING_SIZE - 1)) != 0
+#error "TASK_TRACE_RING_SIZE must be a power of two"
+#endif
+
+#define RING_MASK       (TASK_TRACE_RING_SIZE - 1)
+#define MAX_EVENT_LEN   6       /* [hdr:1] + worst-case varint:5 */
+
+typedef struct {
+    uint8_t  buf[TASK_TRACE_RING_SIZE];
+    volatile uint32_t head;     /* Write index — owning core's scheduler */
+    volatile uint32_t tail;     /* Read index — flusher only */
+    uint32_t last_enq_ts;       /* TIMERAWL of newest enqueued event */
+    uint32_t chain_ts;          /* Absolute time of newest FLUSHED event */
+    uint8_t  seq;               /* Per-core wire block sequence */
+    uint32_t dropped;           /* Events dropped (ring full / pre-init) */
+} trace_ring_t;
+
+static trace_ring_t s_rings[2];
+static char s_trace_rtt_buffer[TASK_TRACE_RTT_BUFFER_SIZE];
+static bool s_trace_ready = false;
+
+/* Per-core switch-in counters for the core-load telemetry packet.
+ * Counted even when the ring is full or pre-init — load accounting
+ * must not depend on the trace stream keeping up. Read lock-free by
+ * the supervisor (single aligned words, atomic on M0+). */
+static volatile uint32_t s_switch_count[2];
+
+/* =========================================================================
+ * Init
+ * ========================================================================= */
+
+void task_trace_init(void) {
+    memset(s_rings, 0, sizeof(s_rings));
+
+    SEGGER_RTT_ConfigUpBuffer(
+        TASK_TRACE_RTT_CHANNEL,
+        "TaskTrace",
+        s_trace_rtt_buffer,
+        sizeof(s_trace_rtt_buffer),
+        SEGGER_RTT_MODE_NO_BLOCK_SKIP
+    );
+
+    uint32_t now = timer_hw->timerawl;
+    s_rings[0].last_enq_ts = s_rings[0].chain_ts = now;
+    s_rings[1].last_enq_ts = s_rings[1].chain_ts = now;
+
+    s_trace_ready = true;
+
+    printf("[task_trace] Init complete, RTT ch%d, ring=%dB/core\n",
+           TASK_TRACE_RTT_CHANNEL, TASK_TRACE_RING_SIZE);
+}
+
+/* =========================================================================
+ * Producer — called from the context-switch path
+ * ========================================================================= */
+
+void _task_trace_switch(unsigned dir_in, unsigned task_number) {
+    unsigned core = get_core_num();
+    if (dir_in) s_switch_count[core]++;
+
+    if (!s_trace_ready) return;
+
+    trace_ring_t *ring = &s_rings[core];
+
+    uint32_t head = ring->head;
+    if (head - ring->tail > TASK_TRACE_RING_SIZE - MAX_EVENT_LEN) {
+        ring->dropped++;        /* Flusher stalled — shed, don't block */
+        return;
+    }
+
+    uint32_t now = timer_hw->timerawl;
+    uint32_t delta = now - ring->last_enq_ts;   /* Unsigned wrap-safe */
+    ring->last_enq_ts = now;
+
+    ring->buf[head & RING_MASK] =
+        (uint8_t)(((dir_in & 1u) << 7) | (task_number & 0x7Fu));
+    head++;
+
+    /* Inline varint — same encoding as log_varint_encode_u32(), open-
+     * coded so the hook has no call into flash-resident helpers. */
+    while (delta > 0x7Fu) {
+        ring->buf[head & RING_MASK] = (uint8_t)(delta | 0x80u);
+        head++;
+        delta >>= 7;
+    }
+    ring->buf[head & RING_MASK] = (uint8_t)delta;
+    head++;
+
+    /* Publish — compiler barrier; M0+ is in-order, no DMB needed */
+    __asm volatile("" ::: "memory");
+    ring->head = head;
+}
+
+/* =========================================================================
+ * Consumer — drain both rings to RTT Channel 3
+ * ========================================================================= */
+
+/**
+ * @brief Drain one ring as one or more wire blocks of WHOLE events.
+ *
+ * The published region always starts and ends on event boundaries, and
+ * events are self-delimiting, so the walk below can cut a block at any
+ * event edge when the staging buffer fills.
+ */
+static unsigned _drain_ring(unsigned core) {
+    trace_ring_t *ring = &s_rings[core];
+    unsigned written = 0;
+
+    uint32_t head = ring->head;     /* Snapshot — producer may advance */
+    uint32_t tail = ring->tail;
+
+    while (tail != head) {
+        uint8_t block[TASK_TRACE_MAX_BLOCK];
+        unsigned pos = 8;           /* Header filled in below */
+
+        /* Copy whole events until the block or the ring is exhausted,
+         * decoding each delta so the block header can carry the exact
+         * absolute timestamp of its last event (the re-anchor). */
+        while (tail != head && pos + MAX_EVENT_LEN <= sizeof(block)) {
+            block[pos++] = ring->buf[tail & RING_MASK];     /* dir|task */
+            tail++;
+            uint32_t delta = 0;
+            unsigned shift = 0;
+            uint8_t b;
+            do {                                            /* varint */
+                b = ring->buf[tail & RING_MASK];
+                tail++;
+                block[pos++] = b;
+                delta |= (uint32_t)(b & 0x7Fu) << shift;
+                shift += 7;
+            } while (b & 0x80u);
+            ring->chain_ts += delta;
+        }
+
+        uint16_t payload_len = (uint16_t)(pos - 8);
+        block[0] = (uint8_t)(0xC0u | core);
+        block[1] = ring->seq++;
+        memcpy(&block[2], &payload_len, 2);
+        memcpy(&block[4], &ring->chain_ts, 4);
+
+        written += SEGGER_RTT_WriteNoLock(TASK_TRACE_RTT_CHANNEL, block, pos);
+    }
+
+    ring->tail = tail;
+    return written;
+}
+
+unsigned task_trace_flush(void) {
+    unsigned written = 0;
+    taskENTER_CRITICAL();
+    written += _drain_ring(0);
+    written += _drain_ring(1);
+    taskEXIT_CRITICAL();
+    return written;
+}
+
+uint32_t task_trace_dropped(void) {
+    return s_rings[0].dropped + s_rings[1].dropped;
+}
+
+uint32_t task_trace_switch_count(unsigned core) {
+    return (core < 2) ? s_switch_count[core] : 0;
+}
+
+/* =========================================================================
+ * Flusher Task
+ * ========================================================================= */
+
+static void _task_trace_flusher(void *params) {
+    (void)params;
+
+    printf("[task_trace] Flusher started, period=%dms\n",
+           TASK_TRACE_FLUSH_PERIOD_MS);
+
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        task_trace_flush();
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TASK_TRACE_FLUSH_PERIOD_MS));
+    }
+}
+
+bool task_trace_start_flusher(void) {
+    BaseType_t ret = xTaskCreate(
+        _task_trace_flusher,
+        "trace_flush",
+        TASK_TRACE_FLUSHER_STACK_SIZE,
+        NULL,
+        TASK_TRACE_FLUSHER_PRIORITY,
+        NULL
+    );
+
+    if (ret != pdPASS) {
+        printf("[task_trace] Failed to create flusher task\n");
+        return false;
+    }
+    return true;
+}
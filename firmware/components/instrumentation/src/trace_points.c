@@ -0,0 +1,117 @@
+/**
+ * @file trace_points.c
+ * @brief Hot-path latency tracepoints — per-core accumulation + emit.
+ *
+ * Stats live in per-core arrays so the two cores never contend; the
+ * ENTER/EXIT update masks local interrupts for a few cycles (same-core
+ * ISR safety), never a cross-core spin lock — the measurement must not
+ * distort what it measures.
+ *
+ * Timer source: TIMERAWL (RP2040 1MHz timer, low 32 bits, raw read —
+ * unlike TIMELR it does not latch TIMEHR, so it is side-effect free
+ * from both cores). Intervals are 32-bit deltas; wrap at ~71 minutes
+ * is handled by unsigned subtraction.
+ */
+
+#include "trace_points.h"
+#include "telemetry.h"          /* TELEMETRY_PKT_TRACE_STATS */
+#include "hardware/timer.h"     /* timer_hw */
+#include "hardware/sync.h"      /* save_and_disable_interrupts() */
+#include "pico/platform.h"      /* get_core_num() */
+#include <string.h>
+
+/* Forward declaration — defined in telemetry_driver.c */
+extern unsigned telemetry_write_packet(const void *data, unsigned length);
+
+/* =========================================================================
+ * Per-Core State
+ * ========================================================================= */
+
+static trace_stats_t s_stats[2][AI_TRACE_MAX_POINTS];
+
+static inline uint32_t _now_us(void) {
+    return timer_hw->timerawl;
+}
+
+/* =========================================================================
+ * ENTER / EXIT
+ * ========================================================================= */
+
+void _trace_enter(uint8_t id) {
+    if (id >= AI_TRACE_MAX_POINTS) return;
+    /* Single store — no masking needed; EXIT reads it on the same core */
+    s_stats[get_core_num()][id].enter_ts = _now_us() | 1u;  /* |1: never 0 */
+}
+
+void _trace_exit(uint8_t id) {
+    if (id >= AI_TRACE_MAX_POINTS) return;
+
+    uint32_t now = _now_us();
+    uint32_t save = save_and_disable_interrupts();
+
+    trace_stats_t *st = &s_stats[get_core_num()][id];
+    if (st->enter_ts == 0) {
+        restore_interrupts(save);
+        return;  /* EXIT without ENTER — ignore */
+    }
+
+    uint32_t delta = now - (st->enter_ts & ~1u);
+    st->enter_ts = 0;
+
+    if (st->count == 0 || delta < st->min_us) st->min_us = delta;
+    if (delta > st->max_us) st->max_us = delta;
+    st->sum_us += delta;
+    st->count++;
+
+    restore_interrupts(save);
+}
+
+/* =========================================================================
+ * Packet Emission
+ *
+ * Packet layout (one packet per core with any completed tracepoints):
+ *   [TELEMETRY_PKT_TRACE_STATS:1][core:1][entry_count:1]
+ *   per entry: [id:1][count:4][min_us:4][max_us:4][mean_us:4]
+ * ========================================================================= */
+
+void trace_points_emit(void) {
+    for (unsigned core = 0; core < 2; core++) {
+        uint8_t packet[3 + AI_TRACE_MAX_POINTS * 17];
+        unsigned pos = 3;
+        uint8_t entry_count = 0;
+
+        for (uint8_t id = 0; id < AI_TRACE_MAX_POINTS; id++) {
+            trace_stats_t *st = &s_stats[core][id];
+            if (st->count == 0) continue;
+
+            /* Snapshot + reset under masked IRQs — the owning core may
+             * complete a pair mid-read. Cross-core tearing of a stat
+             * from the other core's window is tolerable (telemetry,
+             * not control flow) and avoids any spin lock here. */
+            uint32_t save = save_and_disable_interrupts();
+            uint32_t count = st->count;
+            uint32_t min_us = st->min_us;
+            uint32_t max_us = st->max_us;
+            uint64_t sum_us = st->sum_us;
+            st->count = 0;
+            st->sum_us = 0;
+            restore_interrupts(save);
+
+            uint32_t mean_us = (uint32_t)(sum_us / count);
+
+            packet[pos++] = id;
+            memcpy(&packet[pos], &count, 4);   pos += 4;
+            memcpy(&packet[pos], &min_us, 4);  pos += 4;
+            memcpy(&packet[pos], &max_us, 4);  pos += 4;
+            memcpy(&packet[pos], &mean_us, 4); pos += 4;
+            entry_count++;
+        }
+
+        if (entry_count == 0) continue;
+
+        packet[0] = TELEMETRY_PKT_TRACE_STATS;
+        packet[1] = (uint8_t)core;
+        packet[2] = entry_count;
+        telemetry_write_packet(packet, pos);
+    }
+}
@@ -24,6 +24,33 @@ typedef struct {
 #define AI_LOG_ARG_U(val)   ((ai_log_arg_t){ .i = (int32_t)(val), .is_float = false })
 #define AI_LOG_ARG_F(val)   ((ai_log_arg_t){ .f = (float)(val),   .is_float = true  })
 
+/* =========================================================================
+ * Compile-Time Token Hashing
+ *
+ * FNV-1a 32-bit, identical to the host-side hash in gen_tokens.py.
+ * The hash lives here (not log_core.c) so it inlines at every call site:
+ * LOG_xxx() always passes a string LITERAL, so after inlining the whole
+ * loop runs over known bytes and GCC folds it to a single 32-bit constant
+ * at -O1 and above (the Pico SDK default is Release/-O3). The per-character
+ * hash walk that used to run inside _ai_log_write() on every call is gone
+ * from the hot path entirely.
+ * ========================================================================= */
+
+#define AI_LOG_FNV1A_32_INIT    0x811c9dc5u
+#define AI_LOG_FNV1A_32_PRIME   0x01000193u
+
+/** Hash a format string to its 32-bit token.
+ *  Must produce identical results to fnv1a_hash() in gen_tokens.py. */
+__attribute__((always_inline))
+static inline uint32_t _ai_log_token(const char *str) {
+    uint32_t hash = AI_LOG_FNV1A_32_INIT;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= AI_LOG_FNV1A_32_PRIME;
+    }
+    return hash;
+}
+
 /* =========================================================================
  * Core Functions (implemented in log_core.c)
  * ========================================================================= */
@@ -40,15 +67,89 @@ void ai_log_init(void);
 /**
  * @brief Internal: Write a tokenized log packet to RTT.
  * @note Do not call directly — use LOG_xxx macros.
+ * @param token Precomputed FNV-1a token (compile-time constant at call sites)
  */
-void _ai_log_write(uint8_t level, const char *fmt,
+void _ai_log_write(uint8_t level, uint32_t token,
                     const ai_log_arg_t *args, uint8_t arg_count);
 
 /**
  * @brief Internal: Write a zero-argument log packet (fast path).
  * @note Do not call directly — use LOG_xxx macros.
  */
-void _ai_log_write_simple(uint8_t level, const char *fmt);
+void _ai_log_write_simple(uint8_t level, uint32_t token);
+
+/**
+ * @brief Internal: ISR-safe tokenized packet writer.
+ *
+ * Identical wire format to _ai_log_write() but guaranteed never to take
+ * a critical section: the packet goes straight into the calling core's
+ * SPSC ring via the masked-IRQ reserve/commit path. Bounded cost —
+ * encode + ring copy, no lock, no scheduler interaction.
+ *
+ * @note Do not call directly — use LOG_xxx_FROM_ISR macros.
+ */
+void _ai_log_write_from_isr(uint8_t level, uint32_t token,
+                             const ai_log_arg_t *args, uint8_t arg_count);
+
+/**
+ * @brief Internal: ISR-safe zero-argument packet writer.
+ * @note Do not call directly — use LOG_xxx_S_FROM_ISR macros.
+ */
+void _ai_log_write_simple_from_isr(uint8_t level, uint32_t token);
+
+/**
+ * @brief Set the runtime log level ceiling.
+ *
+ * Call sites above AI_LOG_LEVEL_MIN are compiled out; this gate filters
+ * among the ones that remain, at the cost of one volatile byte compare
+ * in the writer. Used by the telemetry supervisor to demote DEBUG/INFO
+ * chatter when RTT backpressure shows the host is not draining.
+ * Clamped to AI_LOG_LEVEL_MIN (cannot enable compiled-out levels).
+ */
+void ai_log_set_runtime_level(uint8_t level);
+
+/**
+ * @brief Current runtime log level ceiling (AI_LOG_LEVEL_MIN at boot).
+ */
+uint8_t ai_log_get_runtime_level(void);
+
+/**
+ * @brief Start the log flusher task (per-core ring mode).
+ *
+ * Creates the low-priority task that drains both per-core rings into
+ * RTT Channel 1. Call from main() before vTaskStartScheduler().
+ * No-op (returns true) when AI_LOG_USE_CORE_RINGS is 0.
+ *
+ * @return true if the flusher is running (or not needed)
+ */
+bool ai_log_start_flusher(void);
+
+/* =========================================================================
+ * Per-Module Log Domain Declaration
+ *
+ * Usage (file scope, once per .c file, before the first LOG_xxx call):
+ *   AI_LOG_MODULE(main);
+ *
+ * Expands to an enum constant carrying the module's compile-time
+ * threshold from ai_log_config.h (AI_LOG_MODULE_LEVEL_<name>). The
+ * emit macros compare against it alongside AI_LOG_LEVEL_MIN — both are
+ * integer constants, so a below-threshold site is dead at compile time
+ * and the optimizer deletes the call AND its argument expressions.
+ * gen_tokens.py parses the same declaration + thresholds, so the site
+ * also vanishes from the token database.
+ *
+ * Logging without a declaration fails with "'_ai_log_module_max'
+ * undeclared" — add AI_LOG_MODULE(<name>) to the file and register the
+ * threshold in ai_log_config.h.
+ * ========================================================================= */
+
+#define AI_LOG_MODULE(name) \
+    enum { _ai_log_module_max = AI_LOG_MODULE_LEVEL_##name }
+
+/** True when `level` survives both the global floor and the module
+ *  threshold. Pure integer-constant expression at every call site. */
+#define _AI_LOG_ENABLED(level) \
+    ((level) <= AI_LOG_LEVEL_MIN && (level) <= _ai_log_module_max)
 
 /* =========================================================================
  * Argument Counting Macro (0-8 args)
@@ -68,23 +169,24 @@ void _ai_log_write_simple(uint8_t level, const char *fmt);
  *   LOG_ERROR("Sensor timeout");
  *   LOG_DEBUG("ADC reading: %d mV, temp: %f C", AI_LOG_ARG_I(mv), AI_LOG_ARG_F(temp));
  *
- * Format string is hashed at runtime with FNV-1a (< 1μs).
+ * Format string is hashed at COMPILE TIME via _ai_log_token() — the
+ * runtime cost is loading one 32-bit constant.
  * Arguments MUST be wrapped in AI_LOG_ARG_I(), AI_LOG_ARG_U(), or AI_LOG_ARG_F().
  * ========================================================================= */
 
 #define _AI_LOG_EMIT(level, fmt, ...) \
     do { \
-        if ((level) <= AI_LOG_LEVEL_MIN) { \
+        if (_AI_LOG_ENABLED(level)) { \
             const ai_log_arg_t _ai_args[] = { __VA_ARGS__ }; \
-            _ai_log_write((level), (fmt), _ai_args, \
+            _ai_log_write((level), _ai_log_token(fmt), _ai_args, \
                          (uint8_t)(sizeof(_ai_args) / sizeof(_ai_args[0]))); \
         } \
     } while (0)
 
 #define _AI_LOG_EMIT_SIMPLE(level, fmt) \
     do { \
-        if ((level) <= AI_LOG_LEVEL_MIN) { \
-            _ai_log_write_simple((level), (fmt)); \
+        if (_AI_LOG_ENABLED(level)) { \
+            _ai_log_write_simple((level), _ai_log_token(fmt)); \
         } \
     } while (0)
 
@@ -100,4 +202,55 @@ void _ai_log_write_simple(uint8_t level, const char *fmt);
 #define LOG_INFO_S(fmt)      _AI_LOG_EMIT_SIMPLE(AI_LOG_LEVEL_INFO,  fmt)
 #define LOG_DEBUG_S(fmt)     _AI_LOG_EMIT_SIMPLE(AI_LOG_LEVEL_DEBUG, fmt)
 
+/* =========================================================================
+ * ISR-Safe Logging Macros
+ *
+ * Usage (from any interrupt handler, including nested/high-priority):
+ *   LOG_DEBUG_FROM_ISR("DMA done, ch=%d", AI_LOG_ARG_I(ch));
+ *   LOG_WARN_S_FROM_ISR("GPIO edge glitch");
+ *
+ * These never take a critical section — the packet is committed into
+ * the calling core's SPSC ring with a bounded, deterministic number of
+ * cycles. Requires the per-core ring mode (AI_LOG_USE_CORE_RINGS=1).
+ * ========================================================================= */
+
+#if !AI_LOG_USE_CORE_RINGS
+/* The direct RTT path uses taskENTER_CRITICAL(), which is illegal from
+ * an ISR and unsafe against the other core without it. */
+#define _AI_LOG_ISR_GUARD() \
+    _Static_assert(0, "LOG_xxx_FROM_ISR requires AI_LOG_USE_CORE_RINGS=1")
+#else
+#define _AI_LOG_ISR_GUARD() do { } while (0)
+#endif
+
+#define _AI_LOG_EMIT_ISR(level, fmt, ...) \
+    do { \
+        _AI_LOG_ISR_GUARD(); \
+        if (_AI_LOG_ENABLED(level)) { \
+            const ai_log_arg_t _ai_args[] = { __VA_ARGS__ }; \
+            _ai_log_write_from_isr((level), _ai_log_token(fmt), _ai_args, \
+                         (uint8_t)(sizeof(_ai_args) / sizeof(_ai_args[0]))); \
+        } \
+    } while (0)
+
+#define _AI_LOG_EMIT_SIMPLE_ISR(level, fmt) \
+    do { \
+        _AI_LOG_ISR_GUARD(); \
+        if (_AI_LOG_ENABLED(level)) { \
+            _ai_log_write_simple_from_isr((level), _ai_log_token(fmt)); \
+        } \
+    } while (0)
+
+/* --- With arguments --- */
+#define LOG_ERROR_FROM_ISR(fmt, ...)  _AI_LOG_EMIT_ISR(AI_LOG_LEVEL_ERROR, fmt, __VA_ARGS__)
+#define LOG_WARN_FROM_ISR(fmt, ...)   _AI_LOG_EMIT_ISR(AI_LOG_LEVEL_WARN,  fmt, __VA_ARGS__)
+#define LOG_INFO_FROM_ISR(fmt, ...)   _AI_LOG_EMIT_ISR(AI_LOG_LEVEL_INFO,  fmt, __VA_ARGS__)
+#define LOG_DEBUG_FROM_ISR(fmt, ...)  _AI_LOG_EMIT_ISR(AI_LOG_LEVEL_DEBUG, fmt, __VA_ARGS__)
+
+/* --- Without arguments --- */
+#define LOG_ERROR_S_FROM_ISR(fmt)     _AI_LOG_EMIT_SIMPLE_ISR(AI_LOG_LEVEL_ERROR, fmt)
+#define LOG_WARN_S_FROM_ISR(fmt)      _AI_LOG_EMIT_SIMPLE_ISR(AI_LOG_LEVEL_WARN,  fmt)
+#define LOG_INFO_S_FROM_ISR(fmt)      _AI_LOG_EMIT_SIMPLE_ISR(AI_LOG_LEVEL_INFO,  fmt)
+#define LOG_DEBUG_S_FROM_ISR(fmt)     _AI_LOG_EMIT_SIMPLE_ISR(AI_LOG_LEVEL_DEBUG, fmt)
+
 #endif /* AI_LOG_H */
@@ -21,6 +21,33 @@
  *  BLOCK_IF_FIFO_FULL = block until space (NEVER use in RT system). */
 #define AI_LOG_RTT_MODE             SEGGER_RTT_MODE_NO_BLOCK_SKIP
 
+/* =========================================================================
+ * Per-Core Ring Buffers (lock-free producer path)
+ * ========================================================================= */
+
+/** Route log packets through per-core SPSC rings drained by a flusher
+ *  task, instead of taking a critical section per packet. Eliminates
+ *  cross-core spin-lock contention on the producer side.
+ *  Set to 0 to restore the direct critical-section RTT write. */
+#ifndef AI_LOG_USE_CORE_RINGS
+#define AI_LOG_USE_CORE_RINGS       1
+#endif
+
+/** Per-core ring capacity in bytes. Must be a power of two.
+ *  2KB per core ≈ 150-400 packets of headroom between flushes. */
+#define AI_LOG_RING_SIZE            2048
+
+/** Flusher task drain period. 10ms keeps worst-case ring occupancy low
+ *  even with both cores logging in tight loops. */
+#define AI_LOG_FLUSH_PERIOD_MS      10
+
+/** Flusher task priority — just above idle, same tier as the supervisor.
+ *  Draining logs must never starve application tasks. */
+#define AI_LOG_FLUSHER_PRIORITY     (tskIDLE_PRIORITY + 1)
+
+/** Flusher task stack size (words). Drain loop + RTT write only. */
+#define AI_LOG_FLUSHER_STACK_SIZE   (configMINIMAL_STACK_SIZE)
+
 /* =========================================================================
  * Log Levels
  * ========================================================================= */
@@ -38,13 +65,93 @@
 #define AI_LOG_LEVEL_MIN            AI_LOG_LEVEL_DEBUG  /* Include all levels by default */
 #endif
 
+/* =========================================================================
+ * Per-Module Log Domains
+ * ========================================================================= */
+
+/** Every source file that logs declares its domain once, before its
+ *  first LOG_xxx call:
+ *
+ *      AI_LOG_MODULE(main);
+ *
+ *  and registers a threshold below. A call site compiles in only when
+ *  its level clears BOTH the global AI_LOG_LEVEL_MIN and the module
+ *  threshold — below either, the site costs literally nothing: the
+ *  whole statement (argument expressions included) folds away, and
+ *  gen_tokens.py applies the same rules so no token-table entry is
+ *  emitted. This keeps DEBUG chatter in cold modules while a hot loop's
+ *  module can be clamped to WARN without touching its source.
+ *
+ *  A file that logs under an unregistered module fails the build with
+ *  "'AI_LOG_MODULE_LEVEL_<name>' undeclared" — add its entry here.
+ *  Each entry is #ifndef-guarded so a build can override it the same
+ *  way as AI_LOG_LEVEL_MIN. */
+
+#ifndef AI_LOG_MODULE_LEVEL_main
+#define AI_LOG_MODULE_LEVEL_main    AI_LOG_LEVEL_DEBUG
+#endif
+
+/* =========================================================================
+ * Flash Persistence (optional)
+ * ========================================================================= */
+
+/** Mirror the tokenized log stream into a raw circular flash region
+ *  (FS_LOG_RING_OFFSET/FS_LOG_RING_SIZE in fs_config.h) so deployed
+ *  units without a debug probe keep the last ~16KB of history for
+ *  post-incident analysis. The flusher stages the same framed bytes it
+ *  writes to RTT into a RAM ring; a background task programs them in
+ *  page-aligned batches via flash_safe_op, so the logging hot path
+ *  never touches flash. Decode a dumped region with
+ *  tools/logging/log_decoder.py --file. Off by default — enable with
+ *  -DAI_LOG_FLASH_PERSIST=1. */
+#ifndef AI_LOG_FLASH_PERSIST
+#define AI_LOG_FLASH_PERSIST        0
+#endif
+
+/** RAM staging ring between the flusher and the persist task (bytes).
+ *  Must be a power of two. 1KB ≈ one second of moderate logging. */
+#define AI_LOG_PERSIST_STAGE_SIZE   1024
+
+/** Persist task wakeup period. Each wakeup programs at most the full
+ *  pages currently staged — flash cost stays amortized and bounded. */
+#define AI_LOG_PERSIST_PERIOD_MS    1000
+
+/** Flush a partially filled page after this many idle wakeups, so low
+ *  log volume still reaches flash within a few seconds of being
+ *  emitted (a padded page costs ring capacity, so don't rush it). */
+#define AI_LOG_PERSIST_MAX_HOLD     5
+
+/** Persist task priority/stack — idle tier, like the RTT flusher. */
+#define AI_LOG_PERSIST_PRIORITY     (tskIDLE_PRIORITY + 1)
+#define AI_LOG_PERSIST_STACK_SIZE   (configMINIMAL_STACK_SIZE)
+
+/* =========================================================================
+ * Timestamps
+ * ========================================================================= */
+
+/** Prepend a varint-encoded timestamp to every packet: the TIMERAWL
+ *  microsecond delta since the previous packet on the SAME core, so the
+ *  common case costs 1-2 bytes and one timer read. Lets the host
+ *  reconstruct device-side timing instead of trusting RTT arrival time
+ *  (which buffering skews by tens of milliseconds). Presence is signaled
+ *  per-packet via AI_LOG_META_TS_FLAG, so the decoder handles either
+ *  build. Set to 0 to shave the bytes and the timer read. */
+#ifndef AI_LOG_TIMESTAMPS
+#define AI_LOG_TIMESTAMPS           1
+#endif
+
+/** Bit 7 of the meta byte ([flag:1][level:3][argc:4]) — set when the
+ *  packet carries a timestamp delta between the meta byte and the args.
+ *  Levels only need 2 bits, so the level field's top bit was free. */
+#define AI_LOG_META_TS_FLAG         0x80
+
 /* =========================================================================
  * Packet Format Constants
  * ========================================================================= */
 
 /** Maximum number of arguments per log call.
  *  Each arg is varint-encoded (1-5 bytes for int32, 4 bytes for float).
- *  Max packet size = 4 (token) + 1 (level) + 1 (arg count) + 8*5 = 46 bytes. */
+ *  Max packet size = 4 (token) + 1 (meta) + 5 (ts) + 8*5 = 50 bytes. */
 #define AI_LOG_MAX_ARGS             8
 
 /** Maximum packet size in bytes (stack-allocated per log call). */
@@ -0,0 +1,73 @@
+/**
+ * @file log_persist.h
+ * @brief BB2: Flash-backed log persistence ring — public API.
+ *
+ * Optional sink behind the RTT flusher (AI_LOG_FLASH_PERSIST): the same
+ * framed tokenized packets that go to RTT Channel 1 are staged into a
+ * RAM ring and programmed in page-aligned batches into the raw flash
+ * region at FS_LOG_RING_OFFSET (fs_config.h — separate from LittleFS).
+ * On a returned unit the region holds the last ~16KB of log history
+ * even when no debug probe was ever attached.
+ *
+ * Flash page format (256B, W25Q16JV program granularity):
+ *
+ *   [magic:2 = 0x504C "LP"][used:2][seq:4]  8B header
+ *   [payload: used bytes of the RTT Channel 1 byte stream, 0xFF pad]
+ *
+ * The payload is a pure continuation — concatenating payloads in seq
+ * order reproduces the exact RTT stream, so the packet format is
+ * unchanged and log_decoder.py --file decodes a dumped region directly.
+ * The per-page seq (monotonic, never 0xFFFFFFFF) locates the write
+ * head at boot and orders pages across the circular wrap, the same
+ * scheme the crash ring uses for its slots.
+ *
+ * Thread safety: log_persist_stage() is single-producer (the RTT
+ * flusher task); the persist task is the only consumer. SPSC ring,
+ * no locks.
+ */
+
+#ifndef LOG_PERSIST_H
+#define LOG_PERSIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Page header magic — "LP" little-endian. Erased flash reads 0xFFFF. */
+#define LOG_PERSIST_PAGE_MAGIC  0x504Cu
+
+/** Page header size; payload capacity is FLASH_PAGE_SIZE minus this. */
+#define LOG_PERSIST_PAGE_HDR    8u
+
+/**
+ * @brief Locate the write head by scanning page headers (boot time).
+ *
+ * Finds the highest sequence number, resumes after it, and skips to
+ * the next sector boundary if the resume page is not blank (the fresh
+ * sector is erased lazily by the persist task before first program).
+ * Call before the scheduler starts, after flash/stdio are up.
+ */
+void log_persist_init(void);
+
+/**
+ * @brief Start the background persist task (flash page programmer).
+ *
+ * @return true if the task was created
+ */
+bool log_persist_start(void);
+
+/**
+ * @brief Stage framed packet bytes for flash (called by the flusher).
+ *
+ * Copies into the RAM staging ring; never blocks, never touches flash.
+ *
+ * @return false if the ring was full (bytes dropped and counted)
+ */
+bool log_persist_stage(const uint8_t *data, unsigned length);
+
+/** Flash pages programmed since boot. */
+uint32_t log_persist_pages_written(void);
+
+/** Bytes dropped because the staging ring was full. */
+uint32_t log_persist_dropped(void);
+
+#endif /* LOG_PERSIST_H */
@@ -0,0 +1,95 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file log_ring.h
+ * @brief BB2: Per-core log packet rings — lock-free producer path.
+ *
+ * One single-producer/single-consumer byte ring per core. Tasks (and,
+ * later, ISRs) on core N write only into ring N, so the producer side
+ * never touches the RP2040 hardware spin locks that taskENTER_CRITICAL()
+ * takes — Core 0 and Core 1 logging simultaneously no longer serialize
+ * against each other.
+ *
+ * A low-priority flusher task drains both rings into RTT Channel 1.
+ * Each packet is prefixed with a sequence byte ([core:1][seq:7], per-core
+ * wrapping) so the host decoder can detect drops and reorder the merged
+ * stream (log_decoder.py --seq-prefix).
+ *
+ * Producer synchronization: tasks on the SAME core can preempt each other
+ * mid-write, so the reserve+copy+publish window briefly masks interrupts
+ * on the local core (save_and_disable_interrupts). That is a handful of
+ * cycles with zero cross-core contention — NOT a spin lock.
+ */
+
+/**
+ * @brief Initialize both per-core rings. Called from ai_log_init().
+ */
+void log_ring_init(void);
+
+/**
+ * @brief Write one complete log packet into the calling core's ring.
+ *
+ * Prepends the [core|seq] byte. If the ring lacks space the packet is
+ * dropped (counted — see log_ring_dropped()).
+ *
+ * @param packet  Encoded log packet (token + level byte + args)
+ * @param length  Packet length in bytes
+ * @return true if queued, false if dropped
+ */
+bool log_ring_write(const uint8_t *packet, unsigned length);
+
+/**
+ * @brief Drain both rings into RTT Channel 1.
+ *
+ * Called by the flusher task (and by ai_log_flush() for synchronous
+ * drains before the scheduler starts). Consumer side takes one critical
+ * section per burst, not per packet.
+ *
+ * @return Number of bytes flushed to RTT
+ */
+unsigned log_ring_flush(void);
+
+/**
+ * @brief Total packets lost: ring full (producer side) plus RTT buffer
+ *        full at flush time (host not draining). Both cores.
+ */
+uint32_t log_ring_dropped(void);
+
+/**
+ * @brief Cumulative bytes accepted by RTT Channel 1.
+ *
+ * Reported in the telemetry vitals header so the host can see the log
+ * channel's throughput next to its drop count.
+ */
+uint32_t log_ring_bytes_flushed(void);
+
+/**
+ * @brief Copy the most recent raw bytes written to one core's ring.
+ *
+ * Crash-context safe: plain reads, no locks, no allocation. Used by
+ * the BB5 crash ring to capture the log tail in a postmortem record.
+ * The copy ends at the current write position and may start mid-entry;
+ * host tooling resynchronizes on the [len][core|seq] framing.
+ *
+ * @param core     Ring to copy (0 or 1)
+ * @param dst      Destination buffer
+ * @param max_len  Capacity of dst
+ * @return Bytes copied (≤ max_len, ≤ bytes ever written)
+ */
+unsigned log_ring_copy_recent(unsigned core, uint8_t *dst, unsigned max_len);
+
+/**
+ * @brief Start the low-priority flusher task.
+ *
+ * Call from main() before vTaskStartScheduler(). Until the task runs,
+ * packets accumulate in the rings (2KB per core of headroom).
+ *
+ * @return true if the task was created
+ */
+bool log_ring_start_flusher(void);
+
+#endif /* LOG_RING_H */
@@ -1,20 +1,30 @@
 /**
  * @file log_core.c
- * @brief BB2: Core logging engine — RTT channel 1 init, FNV-1a hash,
- *        SMP-safe packet writer.
+ * @brief BB2: Core logging engine — RTT channel 1 init, SMP-safe packet writer.
  *
  * Uses SEGGER RTT Channel 1 for binary tokenized log data.
  * All RTT writes are protected by FreeRTOS SMP critical sections
  * (hardware spin locks on RP2040) — NOT SEGGER_RTT_LOCK() which
  * only masks PRIMASK on one core.
+ *
+ * Tokens are FNV-1a hashes of the format strings, computed at COMPILE
+ * TIME by _ai_log_token() in ai_log.h — the writers below receive a
+ * ready-made 32-bit constant and never touch the format string.
  */
 
 #include "ai_log.h"
 #include "ai_log_config.h"
+#include "ai_hot.h"          /* AI_HOT_FUNC — SRAM-resident write path */
 #include "log_varint.h"
+#include "log_ring.h"        /* Per-core SPSC rings (AI_LOG_USE_CORE_RINGS) */
 #include "SEGGER_RTT.h"      /* From pico_stdio_rtt include path */
 #include "FreeRTOS.h"
 #include "task.h"
+#if AI_LOG_TIMESTAMPS
+#include "hardware/timer.h"  /* timer_hw->timerawl */
+#include "hardware/sync.h"   /* save_and_disable_interrupts() */
+#include "pico/platform.h"   /* get_core_num() */
+#endif
 #include <stdarg.h>
 #include <string.h>
 #include <stdio.h>
@@ -26,20 +36,67 @@
 static char s_log_rtt_buffer[AI_LOG_RTT_BUFFER_SIZE];
 static bool s_log_initialized = false;
 
+/** Runtime level gate — starts wide open at the compile-time floor.
+ *  The supervisor demotes this to INFO under RTT backpressure; single
+ *  aligned byte, so plain volatile reads/writes are atomic on M0+. */
+static volatile uint8_t s_runtime_level = AI_LOG_LEVEL_MIN;
+
 /* =========================================================================
- * FNV-1a 32-bit Hash
+ * Per-Packet Timestamp — varint delta from the previous packet, per core
  * ========================================================================= */
 
-#define FNV1A_32_INIT   0x811c9dc5u
-#define FNV1A_32_PRIME  0x01000193u
+#if AI_LOG_TIMESTAMPS
 
-static uint32_t fnv1a_hash(const char *str) {
-    uint32_t hash = FNV1A_32_INIT;
-    while (*str) {
-        hash ^= (uint8_t)*str++;
-        hash *= FNV1A_32_PRIME;
-    }
-    return hash;
+/** TIMERAWL of the last packet per core — producer side only. */
+static uint32_t s_last_ts[2];
+
+/**
+ * @brief Microsecond delta since the previous packet on this core.
+ *
+ * Read + update runs under a brief local-IRQ mask so a same-core
+ * preemption between the two cannot produce a bogus (wrapped) delta.
+ * Unsigned subtraction handles the ~71-minute TIMERAWL wrap.
+ */
+static inline uint32_t _ts_delta(void) {
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t *last = &s_last_ts[get_core_num()];
+    uint32_t now = timer_hw->timerawl;
+    uint32_t delta = now - *last;
+    *last = now;
+    restore_interrupts(save);
+    return delta;
+}
+
+#define _TS_FLAG    AI_LOG_META_TS_FLAG
+#define _TS_APPEND(packet, pos) \
+    do { (pos) += log_varint_encode_u32(_ts_delta(), &(packet)[pos]); } while (0)
+
+#else
+#define _TS_FLAG    0u
+#define _TS_APPEND(packet, pos)     do { } while (0)
+#endif /* AI_LOG_TIMESTAMPS */
+
+/* =========================================================================
+ * Packet Output — per-core ring or direct RTT write
+ * ========================================================================= */
+
+/**
+ * @brief Hand a finished packet off to the configured sink.
+ *
+ * Ring mode (default): enqueue into the calling core's SPSC ring —
+ * no hardware spin lock, so the two cores never serialize against
+ * each other. The flusher task merges both rings into RTT Channel 1.
+ *
+ * Direct mode: legacy behavior — one SMP critical section per packet.
+ */
+static inline void _emit_packet(const uint8_t *packet, unsigned length) {
+#if AI_LOG_USE_CORE_RINGS
+    log_ring_write(packet, length);
+#else
+    taskENTER_CRITICAL();
+    SEGGER_RTT_WriteNoLock(AI_LOG_RTT_CHANNEL, packet, length);
+    taskEXIT_CRITICAL();
+#endif
 }
 
 /* =========================================================================
@@ -55,6 +112,11 @@ void ai_log_init(void) {
         sizeof(s_log_rtt_buffer),
         AI_LOG_RTT_MODE
     );
+
+#if AI_LOG_USE_CORE_RINGS
+    log_ring_init();
+#endif
+
     s_log_initialized = true;
 
     /* Print init message via printf (goes to Channel 0 text stdio) */
@@ -67,21 +129,24 @@ void ai_log_init(void) {
  * Core Packet Writer — with arguments
  * ========================================================================= */
 
-void _ai_log_write(uint8_t level, const char *fmt,
+void AI_HOT_FUNC(_ai_log_write)(uint8_t level, uint32_t token,
                     const ai_log_arg_t *args, uint8_t arg_count) {
     if (!s_log_initialized) return;
+    if (level > s_runtime_level) return;
     if (arg_count > AI_LOG_MAX_ARGS) arg_count = AI_LOG_MAX_ARGS;
 
     uint8_t packet[AI_LOG_MAX_PACKET_SIZE];
     unsigned pos = 0;
 
-    /* 1. Token ID — FNV-1a hash of format string (< 1μs on M0+) */
-    uint32_t token = fnv1a_hash(fmt);
+    /* 1. Token ID — precomputed at the call site (compile-time constant) */
     memcpy(&packet[pos], &token, 4);  /* Little-endian on RP2040 */
     pos += 4;
 
-    /* 2. Level + arg count byte: [level:4][argc:4] */
-    packet[pos++] = (uint8_t)((level & 0x0F) << 4) | (arg_count & 0x0F);
+    /* 2. Meta byte: [ts flag:1][level:3][argc:4] */
+    packet[pos++] = (uint8_t)(_TS_FLAG | ((level & 0x07) << 4) | (arg_count & 0x0F));
+
+    /* 2.5. Varint delta timestamp (AI_LOG_TIMESTAMPS) */
+    _TS_APPEND(packet, pos);
 
     /* 3. Encode each argument as varint or raw float */
     for (uint8_t i = 0; i < arg_count && pos < AI_LOG_MAX_PACKET_SIZE - 5; i++) {
@@ -92,30 +157,102 @@ void _ai_log_write(uint8_t level, const char *fmt,
         }
     }
 
-    /* 4. Write packet atomically to RTT channel 1 with SMP-safe locking.
-     *    FreeRTOS taskENTER_CRITICAL() uses hardware spin locks on RP2040 SMP,
-     *    unlike SEGGER_RTT_LOCK() which only masks PRIMASK on one core.
-     *
-     *    Note: taskENTER_CRITICAL() degrades to interrupt-disable before
-     *    scheduler starts — safe for early boot LOG_xxx calls. */
-    taskENTER_CRITICAL();
-    SEGGER_RTT_WriteNoLock(AI_LOG_RTT_CHANNEL, packet, pos);
-    taskEXIT_CRITICAL();
+    /* 4. Hand off to the packet sink (per-core ring by default).
+     *    Safe for early boot LOG_xxx calls — packets queue in the ring
+     *    until the flusher task starts draining. */
+    _emit_packet(packet, pos);
 }
 
 /* =========================================================================
  * Core Packet Writer — zero-arg fast path
  * ========================================================================= */
 
-void _ai_log_write_simple(uint8_t level, const char *fmt) {
+void AI_HOT_FUNC(_ai_log_write_simple)(uint8_t level, uint32_t token) {
     if (!s_log_initialized) return;
+    if (level > s_runtime_level) return;
 
-    uint8_t packet[6];
-    uint32_t token = fnv1a_hash(fmt);
+    uint8_t packet[10];     /* token + meta + worst-case ts varint */
+    unsigned pos = 4;
     memcpy(&packet[0], &token, 4);
-    packet[4] = (uint8_t)((level & 0x0F) << 4);  /* argc = 0 */
+    packet[pos++] = (uint8_t)(_TS_FLAG | ((level & 0x07) << 4));  /* argc = 0 */
+    _TS_APPEND(packet, pos);
 
-    taskENTER_CRITICAL();
-    SEGGER_RTT_WriteNoLock(AI_LOG_RTT_CHANNEL, packet, 5);
-    taskEXIT_CRITICAL();
+    _emit_packet(packet, pos);
+}
+
+/* =========================================================================
+ * ISR-Safe Packet Writers
+ *
+ * Same encoding as the task-context writers, but the finished packet
+ * goes straight into the calling core's ring — log_ring_write()'s
+ * masked-IRQ reserve/commit is safe from any interrupt priority and
+ * costs a bounded number of cycles. Never compiled in direct mode
+ * (the LOG_xxx_FROM_ISR macros static-assert there).
+ * ========================================================================= */
+
+#if AI_LOG_USE_CORE_RINGS
+
+void AI_HOT_FUNC(_ai_log_write_from_isr)(uint8_t level, uint32_t token,
+                             const ai_log_arg_t *args, uint8_t arg_count) {
+    if (!s_log_initialized) return;
+    if (level > s_runtime_level) return;
+    if (arg_count > AI_LOG_MAX_ARGS) arg_count = AI_LOG_MAX_ARGS;
+
+    uint8_t packet[AI_LOG_MAX_PACKET_SIZE];
+    unsigned pos = 0;
+
+    memcpy(&packet[pos], &token, 4);
+    pos += 4;
+    packet[pos++] = (uint8_t)(_TS_FLAG | ((level & 0x07) << 4) | (arg_count & 0x0F));
+    _TS_APPEND(packet, pos);
+
+    for (uint8_t i = 0; i < arg_count && pos < AI_LOG_MAX_PACKET_SIZE - 5; i++) {
+        if (args[i].is_float) {
+            pos += log_varint_encode_float(args[i].f, &packet[pos]);
+        } else {
+            pos += log_varint_encode_i32(args[i].i, &packet[pos]);
+        }
+    }
+
+    log_ring_write(packet, pos);
+}
+
+void AI_HOT_FUNC(_ai_log_write_simple_from_isr)(uint8_t level, uint32_t token) {
+    if (!s_log_initialized) return;
+    if (level > s_runtime_level) return;
+
+    uint8_t packet[10];     /* token + meta + worst-case ts varint */
+    unsigned pos = 4;
+    memcpy(&packet[0], &token, 4);
+    packet[pos++] = (uint8_t)(_TS_FLAG | ((level & 0x07) << 4));  /* argc = 0 */
+    _TS_APPEND(packet, pos);
+
+    log_ring_write(packet, pos);
+}
+
+#endif /* AI_LOG_USE_CORE_RINGS */
+
+/* =========================================================================
+ * Runtime Level Gate
+ * ========================================================================= */
+
+void ai_log_set_runtime_level(uint8_t level) {
+    if (level > AI_LOG_LEVEL_MIN) level = AI_LOG_LEVEL_MIN;
+    s_runtime_level = level;
+}
+
+uint8_t ai_log_get_runtime_level(void) {
+    return s_runtime_level;
+}
+
+/* =========================================================================
+ * Flusher Task Startup
+ * ========================================================================= */
+
+bool ai_log_start_flusher(void) {
+#if AI_LOG_USE_CORE_RINGS
+    return log_ring_start_flusher();
+#else
+    return true;    /* Direct mode — nothing to flush */
+#endif
 }
@@ -0,0 +1,280 @@
+/**
+ * @file log_persist.c
+ * @brief BB2: Flash-backed log persistence ring — staging + page writer.
+ *
+ * Boot (log_persist_init, pre-scheduler): scan the page headers for the
+ * highest sequence number and resume after it — the same latest-record
+ * scan the crash ring does for its slots. The fresh sector is erased
+ * lazily by the persist task, never on the boot path.
+ *
+ * Runtime: the RTT flusher stages framed packet bytes into an SPSC RAM
+ * ring (log_persist_stage); the persist task drains it into a page
+ * assembly buffer and programs full 256B pages through flash_safe_op.
+ * A partially filled page is held for AI_LOG_PERSIST_MAX_HOLD wakeups
+ * before being padded out, trading a little ring capacity for bounded
+ * time-to-flash at low log volume.
+ */
+
+#include "ai_log_config.h"
+#include "log_persist.h"
+
+#if AI_LOG_FLASH_PERSIST
+
+#include "fs_config.h"          /* FS_LOG_RING_OFFSET / _SIZE */
+#include "flash_safe.h"
+#include "hardware/flash.h"
+#include "pico/platform.h"      /* XIP_BASE */
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <stdio.h>
+
+#if (AI_LOG_PERSIST_STAGE_SIZE & (AI_LOG_PERSIST_STAGE_SIZE - 1)) != 0
+#error "AI_LOG_PERSIST_STAGE_SIZE must be a power of two"
+#endif
+
+#define STAGE_MASK          (AI_LOG_PERSIST_STAGE_SIZE - 1)
+#define PAGE_PAYLOAD        (FLASH_PAGE_SIZE - LOG_PERSIST_PAGE_HDR)
+#define PAGE_COUNT          (FS_LOG_RING_SIZE / FLASH_PAGE_SIZE)
+#define PAGES_PER_SECTOR    (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+
+/* =========================================================================
+ * Page Header
+ * ========================================================================= */
+
+typedef struct {
+    uint16_t magic;             /* LOG_PERSIST_PAGE_MAGIC, 0xFFFF = blank */
+    uint16_t used;              /* Valid payload bytes (<= PAGE_PAYLOAD) */
+    uint32_t seq;               /* Monotonic page sequence, starts at 1 */
+} __attribute__((packed)) page_hdr_t;
+
+_Static_assert(sizeof(page_hdr_t) == LOG_PERSIST_PAGE_HDR,
+               "page header size mismatch with log_persist.h");
+
+static const page_hdr_t *_page_hdr(unsigned index) {
+    return (const page_hdr_t *)
+        (XIP_BASE + FS_LOG_RING_OFFSET + index * FLASH_PAGE_SIZE);
+}
+
+static bool _page_blank(unsigned index) {
+    /* Erased NOR reads all-ones — the magic halfword is enough */
+    return _page_hdr(index)->magic == 0xFFFFu;
+}
+
+/* =========================================================================
+ * Module State
+ * ========================================================================= */
+
+/** SPSC staging ring — producer is the RTT flusher, consumer is the
+ *  persist task. Same head/tail idiom as the per-core log rings. */
+static uint8_t s_stage[AI_LOG_PERSIST_STAGE_SIZE];
+static volatile uint32_t s_stage_head;  /* Write index — flusher only */
+static volatile uint32_t s_stage_tail;  /* Read index — persist task only */
+
+/** Bytes dropped because the staging ring was full. */
+static volatile uint32_t s_dropped;
+
+/** Page index the next program targets, and its sequence number. */
+static unsigned s_next_page;
+static uint32_t s_next_seq;
+
+/** Page assembly buffer — payload accumulates behind the header slot. */
+static uint8_t s_page[FLASH_PAGE_SIZE];
+static unsigned s_page_used;
+
+/** Wakeups the current partial page has been held back. */
+static unsigned s_hold;
+
+/** Pages programmed since boot. */
+static volatile uint32_t s_pages_written;
+
+/** Write is a no-op until init has located the write head. */
+static bool s_ready;
+
+/* =========================================================================
+ * Producer — called by the RTT flusher
+ * ========================================================================= */
+
+bool log_persist_stage(const uint8_t *data, unsigned length) {
+    if (!s_ready) return false;
+
+    uint32_t head = s_stage_head;
+    uint32_t used = head - s_stage_tail;
+
+    if (used + length > AI_LOG_PERSIST_STAGE_SIZE) {
+        s_dropped += length;
+        return false;
+    }
+
+    for (unsigned i = 0; i < length; i++) {
+        s_stage[(head + i) & STAGE_MASK] = data[i];
+    }
+
+    /* Publish — compiler barrier so the bytes land before the index */
+    __asm volatile("" ::: "memory");
+    s_stage_head = head + length;
+    return true;
+}
+
+/* =========================================================================
+ * Flash page writer
+ * ========================================================================= */
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;
+} program_args_t;
+
+static void _program_cb(void *param) {
+    const program_args_t *args = (const program_args_t *)param;
+    flash_range_program(args->offset, args->data, FLASH_PAGE_SIZE);
+}
+
+static void _erase_cb(void *param) {
+    flash_range_erase((uint32_t)(uintptr_t)param, FLASH_SECTOR_SIZE);
+}
+
+/**
+ * @brief Program the assembly buffer into the next page slot.
+ *
+ * Entering a new sector whose first page is occupied means the ring
+ * has wrapped onto its oldest data — erase it first (one erase buys
+ * 16 program-only flushes). Both operations go through flash_safe_op;
+ * this runs in task context only.
+ */
+static void _flush_page(void) {
+    page_hdr_t hdr = {
+        .magic = LOG_PERSIST_PAGE_MAGIC,
+        .used  = (uint16_t)s_page_used,
+        .seq   = s_next_seq,
+    };
+    memcpy(s_page, &hdr, sizeof(hdr));
+
+    /* Pad a partial page — 0xFF programs as NOP on NOR flash */
+    if (s_page_used < PAGE_PAYLOAD) {
+        memset(&s_page[LOG_PERSIST_PAGE_HDR + s_page_used], 0xFF,
+               PAGE_PAYLOAD - s_page_used);
+    }
+
+    uint32_t offset = FS_LOG_RING_OFFSET + s_next_page * FLASH_PAGE_SIZE;
+
+    if (s_next_page % PAGES_PER_SECTOR == 0 && !_page_blank(s_next_page)) {
+        flash_safe_op(_erase_cb, (void *)(uintptr_t)offset);
+    }
+
+    program_args_t args = { .offset = offset, .data = s_page };
+    flash_safe_op(_program_cb, &args);
+
+    s_next_page = (s_next_page + 1) % PAGE_COUNT;
+    s_next_seq++;
+    s_page_used = 0;
+    s_hold = 0;
+    s_pages_written++;
+}
+
+/** Drain the staging ring into the assembly buffer, flushing full pages. */
+static void _drain_staging(void) {
+    uint32_t head = s_stage_head;   /* Snapshot — producer may advance */
+    uint32_t tail = s_stage_tail;
+
+    while (tail != head) {
+        s_page[LOG_PERSIST_PAGE_HDR + s_page_used] = s_stage[tail & STAGE_MASK];
+        tail++;
+        s_page_used++;
+        if (s_page_used == PAGE_PAYLOAD) {
+            s_stage_tail = tail;    /* Free ring space before the lockout */
+            _flush_page();
+        }
+    }
+    s_stage_tail = tail;
+}
+
+/* =========================================================================
+ * Persist Task
+ * ========================================================================= */
+
+static void _log_persist_task(void *params) {
+    (void)params;
+
+    printf("[log_persist] Started, period=%dms, region=%uKB\n",
+           AI_LOG_PERSIST_PERIOD_MS, (unsigned)(FS_LOG_RING_SIZE / 1024));
+
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        _drain_staging();
+
+        /* Low volume: don't sit on a partial page forever */
+        if (s_page_used > 0 && ++s_hold >= AI_LOG_PERSIST_MAX_HOLD) {
+            _flush_page();
+        }
+
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(AI_LOG_PERSIST_PERIOD_MS));
+    }
+}
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+void log_persist_init(void) {
+    uint32_t max_seq = 0;
+    int latest = -1;
+
+    for (unsigned i = 0; i < PAGE_COUNT; i++) {
+        const page_hdr_t *hdr = _page_hdr(i);
+        if (hdr->magic == LOG_PERSIST_PAGE_MAGIC && hdr->seq > max_seq) {
+            max_seq = hdr->seq;
+            latest = (int)i;
+        }
+    }
+
+    s_next_seq = max_seq + 1;
+
+    unsigned next = (latest >= 0)
+                  ? ((unsigned)latest + 1) % PAGE_COUNT
+                  : 0;
+
+    /* An occupied resume page mid-sector means a partial sector from a
+     * previous boot — pages cannot be reprogrammed, so skip ahead to
+     * the next sector boundary and let _flush_page erase it. */
+    if (!_page_blank(next) && (next % PAGES_PER_SECTOR) != 0) {
+        next = ((next / PAGES_PER_SECTOR) + 1)
+             % (PAGE_COUNT / PAGES_PER_SECTOR)
+             * PAGES_PER_SECTOR;
+    }
+
+    s_next_page = next;
+    s_ready = true;
+
+    printf("[log_persist] Ready: %u pages @ 0x%lx, next=%u seq=%lu\n",
+           (unsigned)PAGE_COUNT, (unsigned long)FS_LOG_RING_OFFSET,
+           next, (unsigned long)s_next_seq);
+}
+
+bool log_persist_start(void) {
+    BaseType_t ret = xTaskCreate(
+        _log_persist_task,
+        "log_persist",
+        AI_LOG_PERSIST_STACK_SIZE,
+        NULL,
+        AI_LOG_PERSIST_PRIORITY,
+        NULL
+    );
+
+    if (ret != pdPASS) {
+        printf("[log_persist] Failed to create persist task\n");
+        return false;
+    }
+    return true;
+}
+
+uint32_t log_persist_pages_written(void) {
+    return s_pages_written;
+}
+
+uint32_t log_persist_dropped(void) {
+    return s_dropped;
+}
+
+#endif /* AI_LOG_FLASH_PERSIST */
@@ -0,0 +1,231 @@
+/**
+ * @file log_ring.c
+ * @brief BB2: Per-core SPSC log rings + flusher task.
+ *
+ * Producer (log call on core N):
+ *   1. Mask local interrupts (few cycles — no cross-core spin lock)
+ *   2. Reserve [len][core|seq][payload] in ring N, copy, publish
+ *   3. Restore interrupts
+ *
+ * Consumer (flusher task, any core):
+ *   Drains each ring's published region into RTT Channel 1 in one
+ *   critical section per burst. The rings are SPSC: only the owning
+ *   core advances the write index, only the flusher advances the read
+ *   index, so no lock is needed between producer and consumer — the
+ *   brief IRQ mask on the producer side only serializes same-core tasks.
+ */
+
+#include "ai_log_config.h"
+#include "ai_hot.h"             /* AI_HOT_FUNC — producer runs in SRAM */
+#include "log_ring.h"
+#include "log_persist.h"        /* Optional flash mirror of the stream */
+#include "SEGGER_RTT.h"
+#include "hardware/sync.h"      /* save_and_disable_interrupts() */
+#include "pico/platform.h"      /* get_core_num() */
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * Per-Core Ring State
+ * ========================================================================= */
+
+#if (AI_LOG_RING_SIZE & (AI_LOG_RING_SIZE - 1)) != 0
+#error "AI_LOG_RING_SIZE must be a power of two"
+#endif
+
+#define RING_MASK   (AI_LOG_RING_SIZE - 1)
+
+typedef struct {
+    uint8_t  buf[AI_LOG_RING_SIZE];
+    volatile uint32_t head;     /* Write index — owning core only */
+    volatile uint32_t tail;     /* Read index — flusher only */
+    uint8_t  seq;               /* Per-core 7-bit sequence counter */
+    uint32_t dropped;           /* Packets dropped (ring full) */
+} core_ring_t;
+
+static core_ring_t s_rings[2];
+
+/** Bytes accepted by RTT Channel 1 (cumulative, both cores). */
+static volatile uint32_t s_rtt_flushed_bytes;
+
+/** Packets RTT refused in NO_BLOCK_SKIP mode — host not draining.
+ *  Folded into log_ring_dropped() alongside ring-full drops. */
+static volatile uint32_t s_rtt_dropped;
+
+/* =========================================================================
+ * Init
+ * ========================================================================= */
+
+void log_ring_init(void) {
+    memset(s_rings, 0, sizeof(s_rings));
+}
+
+/* =========================================================================
+ * Producer — lock-free reserve/copy/publish
+ * ========================================================================= */
+
+bool AI_HOT_FUNC(log_ring_write)(const uint8_t *packet, unsigned length) {
+    /* Entry: [len:1][core|seq:1][payload:length] */
+    unsigned entry_len = 2 + length;
+
+    uint32_t save = save_and_disable_interrupts();
+
+    core_ring_t *ring = &s_rings[get_core_num()];
+    uint32_t head = ring->head;
+    uint32_t used = head - ring->tail;
+
+    if (used + entry_len > AI_LOG_RING_SIZE) {
+        ring->dropped++;
+        restore_interrupts(save);
+        return false;
+    }
+
+    /* [core:1 bit (bit7)][seq:7 bits] — per-core, wraps at 128 */
+    uint8_t seq_byte = (uint8_t)((get_core_num() << 7) | (ring->seq & 0x7F));
+    ring->seq++;
+
+    ring->buf[head & RING_MASK] = (uint8_t)length;
+    head++;
+    ring->buf[head & RING_MASK] = seq_byte;
+    head++;
+    for (unsigned i = 0; i < length; i++) {
+        ring->buf[head & RING_MASK] = packet[i];
+        head++;
+    }
+
+    /* Publish — compiler barrier so the payload is visible before the
+     * index. M0+ is in-order, no DMB needed for same-address ordering. */
+    __asm volatile("" ::: "memory");
+    ring->head = head;
+
+    restore_interrupts(save);
+    return true;
+}
+
+/* =========================================================================
+ * Consumer — drain both rings to RTT Channel 1
+ * ========================================================================= */
+
+/**
+ * @brief Drain one ring: copy published entries to RTT as framed packets.
+ *
+ * On the wire each packet becomes [core|seq:1][payload] — the entry's
+ * internal length byte is consumed here and not transmitted (RTT framing
+ * is the packet structure itself, as before).
+ */
+static unsigned _drain_ring(core_ring_t *ring) {
+    unsigned flushed = 0;
+    uint32_t head = ring->head;     /* Snapshot — producer may advance */
+    uint32_t tail = ring->tail;
+
+    if (tail == head) return 0;
+
+    taskENTER_CRITICAL();
+    while (tail != head) {
+        uint8_t len = ring->buf[tail & RING_MASK];
+        tail++;
+
+        /* Reassemble [seq][payload] contiguously for the RTT write —
+         * the ring may wrap mid-entry. Max log packet is well under 64B. */
+        uint8_t out[1 + AI_LOG_MAX_PACKET_SIZE];
+        out[0] = ring->buf[tail & RING_MASK];
+        tail++;
+        for (unsigned i = 0; i < len; i++) {
+            out[1 + i] = ring->buf[tail & RING_MASK];
+            tail++;
+        }
+
+        unsigned written = SEGGER_RTT_WriteNoLock(AI_LOG_RTT_CHANNEL,
+                                                  out, 1u + len);
+        /* SKIP mode is all-or-nothing per write: 0 = packet lost */
+        if (written > 0) {
+            flushed += written;
+        } else {
+            s_rtt_dropped++;
+        }
+
+#if AI_LOG_FLASH_PERSIST
+        /* Mirror the framed bytes to the flash staging ring regardless
+         * of the RTT outcome — on probe-less units RTT always skips,
+         * and the flash ring is the only copy that survives. */
+        log_persist_stage(out, 1u + len);
+#endif
+    }
+    taskEXIT_CRITICAL();
+
+    s_rtt_flushed_bytes += flushed;
+    ring->tail = tail;
+    return flushed;
+}
+
+unsigned log_ring_flush(void) {
+    unsigned flushed = 0;
+    flushed += _drain_ring(&s_rings[0]);
+    flushed += _drain_ring(&s_rings[1]);
+    return flushed;
+}
+
+uint32_t log_ring_dropped(void) {
+    return s_rings[0].dropped + s_rings[1].dropped + s_rtt_dropped;
+}
+
+uint32_t log_ring_bytes_flushed(void) {
+    return s_rtt_flushed_bytes;
+}
+
+unsigned log_ring_copy_recent(unsigned core, uint8_t *dst, unsigned max_len) {
+    if (core >= 2) return 0;
+
+    /* Crash-context safe: snapshot the head, copy backwards-bounded
+     * history with plain reads. A concurrent producer can overwrite
+     * the oldest bytes mid-copy; the damage is a garbled oldest packet,
+     * which the host-side resync already tolerates. */
+    core_ring_t *ring = &s_rings[core];
+    uint32_t head = ring->head;
+
+    uint32_t avail = (head < AI_LOG_RING_SIZE) ? head : AI_LOG_RING_SIZE;
+    if (avail > max_len) avail = max_len;
+
+    uint32_t start = head - avail;
+    for (uint32_t i = 0; i < avail; i++) {
+        dst[i] = ring->buf[(start + i) & RING_MASK];
+    }
+    return avail;
+}
+
+/* =========================================================================
+ * Flusher Task
+ * ========================================================================= */
+
+static void _log_flusher_task(void *params) {
+    (void)params;
+
+    printf("[log_ring] Flusher started, period=%dms, ring=%dB/core\n",
+           AI_LOG_FLUSH_PERIOD_MS, AI_LOG_RING_SIZE);
+
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        log_ring_flush();
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(AI_LOG_FLUSH_PERIOD_MS));
+    }
+}
+
+bool log_ring_start_flusher(void) {
+    BaseType_t ret = xTaskCreate(
+        _log_flusher_task,
+        "log_flush",
+        AI_LOG_FLUSHER_STACK_SIZE,
+        NULL,
+        AI_LOG_FLUSHER_PRIORITY,
+        NULL
+    );
+
+    if (ret != pdPASS) {
+        printf("[log_ring] Failed to create flusher task\n");
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file mem_pool.h
+ * @brief Fixed-block pool allocator — public API.
+ *
+ * Serves the firmware's small, short-lived allocations (cJSON nodes,
+ * config file buffers) from fixed-size block pools instead of the
+ * FreeRTOS heap_4 free list. Fixed blocks cannot fragment: a free
+ * always produces a reusable block of the same size, so JSON churn no
+ * longer splinters the heap that task stacks and queues live in.
+ *
+ * Three size classes cover the observed allocation profile:
+ *   small  (32B)  — cJSON node structs (~24B each)
+ *   medium (128B) — short strings, printbuffer growth steps
+ *   large  (512B) — config file buffers, serialized JSON output
+ *
+ * Requests that exceed the largest class or find their pool exhausted
+ * fall back to pvPortMalloc() (counted — watch mem_pool_stats_t
+ * .fallback_count in the field to size the pools).
+ *
+ * Thread safety: alloc/free take a FreeRTOS critical section. These
+ * paths are boot/config-time, not hot loops.
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* =========================================================================
+ * Pool Geometry
+ * ========================================================================= */
+
+#define MEM_POOL_SMALL_SIZE     32
+#define MEM_POOL_SMALL_COUNT    48      /* cJSON: ~1 node per JSON key */
+
+#define MEM_POOL_MEDIUM_SIZE    128
+#define MEM_POOL_MEDIUM_COUNT   12
+
+#define MEM_POOL_LARGE_SIZE     512
+#define MEM_POOL_LARGE_COUNT    4       /* Config file + print buffers */
+
+/* =========================================================================
+ * Statistics
+ * ========================================================================= */
+
+/**
+ * @brief Usage counters for one size class.
+ */
+typedef struct {
+    uint16_t in_use;            /**< Blocks currently allocated */
+    uint16_t high_water;        /**< Peak simultaneous allocations */
+    uint32_t alloc_count;       /**< Total allocations served */
+} mem_pool_class_stats_t;
+
+/**
+ * @brief Aggregate pool allocator statistics.
+ */
+typedef struct {
+    mem_pool_class_stats_t small;
+    mem_pool_class_stats_t medium;
+    mem_pool_class_stats_t large;
+    uint32_t fallback_count;    /**< Requests routed to pvPortMalloc() */
+} mem_pool_stats_t;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Initialize the pools (builds the free lists).
+ *
+ * Call ONCE from main() before any component that allocates through
+ * the pools (i.e. before fs_manager_init()).
+ */
+void mem_pool_init(void);
+
+/**
+ * @brief Allocate a block of at least `size` bytes.
+ *
+ * Served from the smallest fitting pool; falls back to pvPortMalloc()
+ * if no pool fits or the fitting pool is exhausted.
+ *
+ * @return Block pointer, or NULL if the heap fallback also failed
+ */
+void *mem_pool_alloc(size_t size);
+
+/**
+ * @brief Return a block obtained from mem_pool_alloc().
+ *
+ * Pointers are classified by address range, so heap-fallback pointers
+ * are routed to vPortFree() automatically. NULL is a no-op.
+ */
+void mem_pool_free(void *ptr);
+
+/**
+ * @brief Snapshot the usage counters.
+ */
+void mem_pool_get_stats(mem_pool_stats_t *out);
+
+#endif /* MEM_POOL_H */
@@ -0,0 +1,165 @@
+/**
+ * @file mem_pool.c
+ * @brief Fixed-block pool allocator — free-list implementation.
+ *
+ * Each size class is a static byte array carved into fixed blocks,
+ * threaded onto a singly-linked free list (the link is stored in the
+ * free block itself, so there is no per-block overhead while in use).
+ *
+ * Alloc/free take a FreeRTOS SMP critical section — these are
+ * boot/config-path allocations where correctness beats cycle counting.
+ */
+
+#include "mem_pool.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * Pool Storage
+ * ========================================================================= */
+
+typedef struct free_block {
+    struct free_block *next;
+} free_block_t;
+
+typedef struct {
+    uint8_t     *base;          /* Start of the block array */
+    size_t       block_size;
+    uint16_t     block_count;
+    free_block_t *free_list;
+    mem_pool_class_stats_t stats;
+} pool_t;
+
+/* Block arrays — aligned for the free-list link and any payload type */
+static uint8_t s_small_blocks[MEM_POOL_SMALL_COUNT][MEM_POOL_SMALL_SIZE]
+    __attribute__((aligned(4)));
+static uint8_t s_medium_blocks[MEM_POOL_MEDIUM_COUNT][MEM_POOL_MEDIUM_SIZE]
+    __attribute__((aligned(4)));
+static uint8_t s_large_blocks[MEM_POOL_LARGE_COUNT][MEM_POOL_LARGE_SIZE]
+    __attribute__((aligned(4)));
+
+static pool_t s_pools[3] = {
+    { .base = &s_small_blocks[0][0],
+      .block_size = MEM_POOL_SMALL_SIZE,  .block_count = MEM_POOL_SMALL_COUNT },
+    { .base = &s_medium_blocks[0][0],
+      .block_size = MEM_POOL_MEDIUM_SIZE, .block_count = MEM_POOL_MEDIUM_COUNT },
+    { .base = &s_large_blocks[0][0],
+      .block_size = MEM_POOL_LARGE_SIZE,  .block_count = MEM_POOL_LARGE_COUNT },
+};
+
+static uint32_t s_fallback_count;
+static bool s_initialized;
+
+/* =========================================================================
+ * Init
+ * ========================================================================= */
+
+void mem_pool_init(void) {
+    for (unsigned p = 0; p < 3; p++) {
+        pool_t *pool = &s_pools[p];
+        pool->free_list = NULL;
+
+        /* Thread blocks onto the free list back to front so allocation
+         * order matches address order (helps when staring at dumps). */
+        for (int i = pool->block_count - 1; i >= 0; i--) {
+            free_block_t *blk =
+                (free_block_t *)(pool->base + (size_t)i * pool->block_size);
+            blk->next = pool->free_list;
+            pool->free_list = blk;
+        }
+
+        memset(&pool->stats, 0, sizeof(pool->stats));
+    }
+
+    s_fallback_count = 0;
+    s_initialized = true;
+
+    printf("[mem_pool] Init: %dx%dB + %dx%dB + %dx%dB = %dB static\n",
+           MEM_POOL_SMALL_COUNT, MEM_POOL_SMALL_SIZE,
+           MEM_POOL_MEDIUM_COUNT, MEM_POOL_MEDIUM_SIZE,
+           MEM_POOL_LARGE_COUNT, MEM_POOL_LARGE_SIZE,
+           (int)(sizeof(s_small_blocks) + sizeof(s_medium_blocks) +
+                 sizeof(s_large_blocks)));
+}
+
+/* =========================================================================
+ * Alloc / Free
+ * ========================================================================= */
+
+void *mem_pool_alloc(size_t size) {
+    if (s_initialized) {
+        for (unsigned p = 0; p < 3; p++) {
+            pool_t *pool = &s_pools[p];
+            if (size > pool->block_size) continue;
+
+            taskENTER_CRITICAL();
+            free_block_t *blk = pool->free_list;
+            if (blk != NULL) {
+                pool->free_list = blk->next;
+                pool->stats.in_use++;
+                pool->stats.alloc_count++;
+                if (pool->stats.in_use > pool->stats.high_water) {
+                    pool->stats.high_water = pool->stats.in_use;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if (blk != NULL) return blk;
+            /* Pool exhausted — try the next (larger) class */
+        }
+    }
+
+    /* Oversized request or all fitting pools exhausted */
+    taskENTER_CRITICAL();
+    s_fallback_count++;
+    taskEXIT_CRITICAL();
+    return pvPortMalloc(size);
+}
+
+/**
+ * @brief Find the pool owning a pointer, or NULL for heap fallbacks.
+ */
+static pool_t *_owning_pool(const void *ptr) {
+    for (unsigned p = 0; p < 3; p++) {
+        pool_t *pool = &s_pools[p];
+        const uint8_t *b = (const uint8_t *)ptr;
+        if (b >= pool->base &&
+            b < pool->base + (size_t)pool->block_count * pool->block_size) {
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+void mem_pool_free(void *ptr) {
+    if (ptr == NULL) return;
+
+    pool_t *pool = _owning_pool(ptr);
+    if (pool == NULL) {
+        vPortFree(ptr);  /* Heap fallback pointer */
+        return;
+    }
+
+    free_block_t *blk = (free_block_t *)ptr;
+
+    taskENTER_CRITICAL();
+    blk->next = pool->free_list;
+    pool->free_list = blk;
+    pool->stats.in_use--;
+    taskEXIT_CRITICAL();
+}
+
+/* =========================================================================
+ * Statistics
+ * ========================================================================= */
+
+void mem_pool_get_stats(mem_pool_stats_t *out) {
+    taskENTER_CRITICAL();
+    out->small = s_pools[0].stats;
+    out->medium = s_pools[1].stats;
+    out->large = s_pools[2].stats;
+    out->fallback_count = s_fallback_count;
+    taskEXIT_CRITICAL();
+}
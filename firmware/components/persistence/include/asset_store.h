@@ -0,0 +1,122 @@
+/**
+ * @file asset_store.h
+ * @brief BB4: Zero-copy XIP asset store — public API.
+ *
+ * Serves immutable read-only blobs (calibration tables, waveform data,
+ * ML coefficients) straight out of a dedicated raw-flash region below
+ * the crash ring (see fs_config.h). Lookups return a const pointer into
+ * the memory-mapped XIP window plus a length — zero copy, zero SRAM
+ * residency, no LittleFS fragmentation. A 40KB calibration table costs
+ * exactly 0 bytes of the RP2040's 264KB of RAM.
+ *
+ * The region image is built on the host by tools/assets/pack_assets.py
+ * and flashed at FS_ASSET_REGION_OFFSET. Layout:
+ *
+ *   [asset_index_t][asset_entry_t × count][padding][asset payloads...]
+ *
+ * The index carries a CRC32 over the entry table (validated once at
+ * init); each entry carries a CRC32 over its payload (validated lazily
+ * on the first lookup, then cached — a 64KB region is never CRC'd on
+ * the boot path).
+ *
+ * Thread Safety:
+ *   - asset_store_get() is safe from any task after init. The lazy CRC
+ *     check may run concurrently on two cores for the same asset; both
+ *     compute the same answer, so the race is benign.
+ *   - XIP reads need no flash lockout. Do not call during a flash
+ *     erase/program window (XIP is offline inside flash_safe_op()).
+ */
+
+#ifndef ASSET_STORE_H
+#define ASSET_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* =========================================================================
+ * Region Image Format
+ * ========================================================================= */
+
+/** Magic marking a valid asset region ("ASET"). */
+#define ASSET_STORE_MAGIC       0x41534554u
+
+/** Region format version — bump when the index layout changes. */
+#define ASSET_STORE_VERSION     1u
+
+/** Maximum asset name length, including the NUL terminator. */
+#define ASSET_NAME_MAX          16
+
+/** Maximum number of assets in one region image. Bounds the index to
+ *  one flash page and the validity cache to a single 32-bit word. */
+#define ASSET_STORE_MAX_ASSETS  32
+
+/**
+ * @brief Region header at FS_ASSET_REGION_OFFSET.
+ *
+ * index_crc covers the entry table only (count * sizeof(asset_entry_t)
+ * bytes immediately following this header).
+ */
+typedef struct {
+    uint32_t magic;         /**< ASSET_STORE_MAGIC */
+    uint32_t version;       /**< ASSET_STORE_VERSION */
+    uint32_t count;         /**< Number of entries in the table */
+    uint32_t index_crc;     /**< CRC32 of the entry table */
+} __attribute__((packed)) asset_index_t;
+
+/**
+ * @brief One index entry. offset is relative to the region start.
+ */
+typedef struct {
+    char     name[ASSET_NAME_MAX];  /**< NUL-terminated, NUL-padded */
+    uint32_t offset;                /**< Payload offset within region */
+    uint32_t length;                /**< Payload length in bytes */
+    uint32_t crc32;                 /**< CRC32 of the payload */
+} __attribute__((packed)) asset_entry_t;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Locate and validate the asset region index.
+ *
+ * Reads the index header via XIP, checks magic/version/bounds and the
+ * entry-table CRC. Payload CRCs are deferred to first lookup. An erased
+ * region (0xFF magic) is the normal no-assets-flashed case and returns
+ * false without complaint.
+ *
+ * @return true if a valid index was found (asset_store_get() usable)
+ */
+bool asset_store_init(void);
+
+/**
+ * @brief Look up an asset by name — zero-copy.
+ *
+ * On the first hit for a given asset, its payload CRC32 is verified
+ * (one pass over the blob in XIP); subsequent hits are an index walk
+ * and a pointer add. A CRC failure marks the asset bad permanently.
+ *
+ * @param name    Asset name as given to pack_assets.py
+ * @param data    Out: const pointer into the XIP window (no copy)
+ * @param length  Out: payload length in bytes
+ * @return true if found and CRC-valid
+ */
+bool asset_store_get(const char *name, const void **data, uint32_t *length);
+
+/**
+ * @brief Number of assets in the validated index (0 if init failed).
+ */
+uint32_t asset_store_count(void);
+
+/**
+ * @brief Read-only access to an index entry by position.
+ *
+ * For diagnostics/enumeration (e.g. listing assets over the console).
+ * Does NOT trigger the payload CRC check.
+ *
+ * @return Pointer into the XIP-mapped index, or NULL if out of range
+ */
+const asset_entry_t *asset_store_entry(uint32_t index);
+
+#endif /* ASSET_STORE_H */
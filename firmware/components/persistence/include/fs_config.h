@@ -7,11 +7,16 @@
  *
  * RP2040 Flash Map (2MB W25Q16JV):
  *   0x10000000 - 0x101FFFFF  XIP region (2MB)
- *   0x10000000 - 0x101EFFFF  Firmware (code + read-only data)
+ *   0x10000000 - 0x100FCFFF  Firmware slot A (active image)
+ *   0x100FD000 - 0x101D8FFF  Firmware slot B (880KB update staging)
+ *   0x101D9000 - 0x101DCFFF  Log persist ring (16KB = 4 raw sectors)
+ *   0x101DD000 - 0x101DDFFF  Update control sector (4KB, fw_update)
+ *   0x101DE000 - 0x101EDFFF  Asset store (64KB raw, immutable blobs)
+ *   0x101EE000 - 0x101EFFFF  Crash ring (8KB = 2 raw sectors, no FS)
  *   0x101F0000 - 0x101FFFFF  LittleFS partition (64KB = 16 sectors)
  *
- * ⚠️ The LittleFS partition MUST NOT overlap with firmware code.
- *    Place it at the END of the 2MB flash. Adjust FS_FLASH_OFFSET
+ * ⚠️ The reserved partitions MUST NOT overlap with firmware code.
+ *    Place them at the END of the 2MB flash. Adjust FS_FLASH_OFFSET
  *    if firmware grows beyond ~1.9MB.
  */
 
@@ -36,6 +41,36 @@
  *  ⚠️ This is the offset from XIP_BASE, NOT an absolute address. */
 #define FS_FLASH_OFFSET         (FS_FLASH_TOTAL_SIZE - FS_PARTITION_SIZE)
 
+/** Crash ring size: 2 raw sectors (8KB) for post-mortem records.
+ *  Written directly with flash_range_program from fault context —
+ *  no filesystem involvement, bounded write time. */
+#define FS_CRASH_RING_SIZE      (2 * FLASH_SECTOR_SIZE)
+
+/** Crash ring offset — directly below the LittleFS partition. */
+#define FS_CRASH_RING_OFFSET    (FS_FLASH_OFFSET - FS_CRASH_RING_SIZE)
+
+/** Asset store size: 64KB of raw flash for immutable read-only blobs
+ *  (calibration tables, waveforms, coefficients). Served zero-copy via
+ *  const XIP pointers — never mirrored into SRAM, never touched by
+ *  LittleFS. Flashed as one image by tools/assets/pack_assets.py. */
+#define FS_ASSET_REGION_SIZE    (64 * 1024)
+
+/** Asset store offset — directly below the crash ring. */
+#define FS_ASSET_REGION_OFFSET  (FS_CRASH_RING_OFFSET - FS_ASSET_REGION_SIZE)
+
+/** Log persistence ring: 4 raw sectors (16KB) of circular tokenized
+ *  log history for units running without a debug probe — the stream
+ *  that would otherwise only exist in the RTT Channel 1 buffer.
+ *  Written page-at-a-time by the log_persist task (AI_LOG_FLASH_PERSIST
+ *  in ai_log_config.h); no filesystem involvement. */
+#define FS_LOG_RING_SIZE        (4 * FLASH_SECTOR_SIZE)
+
+/** Log ring offset — directly below the update control sector, carved
+ *  from the top of firmware slot B (FW_UPDATE_SLOT_SIZE shrank from
+ *  896KB to 880KB to match; the control sector did not move). */
+#define FS_LOG_RING_OFFSET      (FS_ASSET_REGION_OFFSET - FLASH_SECTOR_SIZE \
+                                 - FS_LOG_RING_SIZE)
+
 /* =========================================================================
  * LittleFS Block Device Parameters
  * ========================================================================= */
@@ -74,7 +109,14 @@
 /** Directory for configuration files. */
 #define FS_CONFIG_DIR           "/config"
 
-/** Main application configuration file. */
-#define FS_CONFIG_APP_PATH      "/config/app.json"
+/** Main application configuration file — packed binary blob
+ *  (magic + format version + app_config_t + CRC32). Loaded with a
+ *  single lfs_file_read, zero heap allocation on the boot path. */
+#define FS_CONFIG_APP_PATH      "/config/app.bin"
+
+/** Legacy/import JSON configuration file. Parsed (and consumed) at
+ *  boot if present — lets host tooling like config_sync.py stage new
+ *  values as JSON without knowing the binary layout. */
+#define FS_CONFIG_JSON_PATH     "/config/app.json"
 
 #endif /* FS_CONFIG_H */
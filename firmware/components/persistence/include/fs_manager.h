@@ -2,8 +2,9 @@
  * @file fs_manager.h
  * @brief BB4: Persistent configuration manager — public API.
  *
- * Provides a JSON-based configuration store backed by LittleFS on the
- * RP2040's flash. All flash operations go through flash_safe_op() for
+ * Provides a packed-binary configuration store backed by LittleFS on
+ * the RP2040's flash (JSON survives only as an import/export path for
+ * host tooling). All flash operations go through flash_safe_op() for
  * SMP-safe dual-core lockout.
  *
  * Usage:
@@ -12,6 +13,15 @@
  *      to the in-RAM config struct.
  *   3. Modify fields, then call fs_manager_save_config() to persist.
  *
+ * Lazy mount (FS_LAZY_MOUNT, on by default in the fast-boot profile):
+ *   fs_manager_init() returns immediately with DEFAULT_CONFIG active
+ *   and a low-priority loader task performs mount/format/config-load
+ *   after the scheduler starts. Readers that poll
+ *   fs_manager_get_config() each loop pick up the loaded values
+ *   automatically; register fs_manager_on_config_loaded() to be told
+ *   when they arrive. Worst-case boot time no longer depends on flash
+ *   health (a corrupt filesystem format happens in the background).
+ *
  * Thread Safety:
  *   - fs_manager_get_config() is safe from any task (read-only pointer).
  *   - fs_manager_save_config() acquires the flash guard internally.
@@ -24,6 +34,48 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/* =========================================================================
+ * Lazy Mount Configuration
+ * ========================================================================= */
+
+/** Defer mount/format/config-load to a background task. Defaults to
+ *  following the fast-boot build profile; override per-build with
+ *  -DFS_LAZY_MOUNT=0/1. */
+#ifndef FS_LAZY_MOUNT
+#ifdef FAST_BOOT
+#define FS_LAZY_MOUNT               1
+#else
+#define FS_LAZY_MOUNT               0
+#endif
+#endif
+
+/** Loader task stack size (words). Mount + possible format + load. */
+#define FS_LOADER_STACK_SIZE        (configMINIMAL_STACK_SIZE * 2)
+
+/** Loader task priority — just above idle, same tier as the committer.
+ *  The mount (or worst-case full format) steals only idle time. */
+#define FS_LOADER_PRIORITY          (tskIDLE_PRIORITY + 1)
+
+/* =========================================================================
+ * Background Committer Task Configuration
+ * ========================================================================= */
+
+/** Committer task stack size (words). Serialize + LittleFS write. */
+#define FS_COMMITTER_STACK_SIZE     (configMINIMAL_STACK_SIZE * 2)
+
+/** Committer task priority — just above idle. The whole point is that
+ *  the flash erase/program stall happens in a quiet window, not inline
+ *  in the updating task. */
+#define FS_COMMITTER_PRIORITY       (tskIDLE_PRIORITY + 1)
+
+/** Delay between an update and the flash commit. Consecutive updates
+ *  inside this window coalesce into a single erase+program cycle.
+ *  Override per-build with -DFS_COMMIT_DELAY_MS=n — provisioning flows
+ *  that fire many updates back-to-back may want a wider window. */
+#ifndef FS_COMMIT_DELAY_MS
+#define FS_COMMIT_DELAY_MS          250
+#endif
+
 /* =========================================================================
  * Application Configuration Structure
  * ========================================================================= */
@@ -51,13 +103,42 @@ typedef struct {
  * Mounts the filesystem partition. If mount fails (first boot or corrupt),
  * formats the partition and writes default configuration.
  *
+ * With FS_LAZY_MOUNT=1 this only activates DEFAULT_CONFIG and creates
+ * the loader task — mount/format/load happen after scheduler start.
+ *
  * ⚠️ Must be called ONCE from main(), before scheduler starts.
  *
- * @return true on success (filesystem mounted, config loaded)
+ * @return true on success (filesystem mounted, config loaded; in lazy
+ *         mode: loader task created)
  * @return false on failure (flash error, format failed)
  */
 bool fs_manager_init(void);
 
+/**
+ * @brief True once the filesystem is mounted.
+ *
+ * Always true after a successful fs_manager_init() in eager mode; in
+ * lazy mode it turns true when the background loader finishes. Callers
+ * that touch LittleFS directly (e.g. the crash reporter) must check it.
+ */
+bool fs_manager_is_mounted(void);
+
+/**
+ * @brief True once the persisted configuration has been loaded.
+ *
+ * Until then fs_manager_get_config() serves DEFAULT_CONFIG.
+ */
+bool fs_manager_config_ready(void);
+
+/**
+ * @brief Register a callback for when the persisted config arrives.
+ *
+ * Single slot. Invoked from the loader task's context after the load
+ * completes; invoked immediately if the config is already loaded.
+ * Pass NULL to clear.
+ */
+void fs_manager_on_config_loaded(void (*callback)(const app_config_t *cfg));
+
 /**
  * @brief Get a read-only pointer to the current application configuration.
  *
@@ -71,8 +152,8 @@ const app_config_t *fs_manager_get_config(void);
 /**
  * @brief Persist the current in-RAM configuration to flash.
  *
- * Serializes the config struct to JSON via cJSON, writes to
- * /config/app.json on LittleFS. Uses flash_safe_op() internally.
+ * Writes the packed binary blob (magic + version + struct + CRC32) to
+ * /config/app.bin on LittleFS. Uses flash_safe_op() internally.
  *
  * ⚠️ Do NOT call from ISR context.
  * ⚠️ Blocks briefly during flash erase/program (~2-5ms per sector).
@@ -83,17 +164,64 @@ const app_config_t *fs_manager_get_config(void);
 bool fs_manager_save_config(void);
 
 /**
- * @brief Update a specific configuration field and persist.
+ * @brief Update a specific configuration field and schedule persistence.
  *
- * Convenience function: modifies the in-RAM config and saves to flash.
+ * Each field is compared against its current value first — an update
+ * that changes nothing is a no-op: no version bump, no dirty mark, no
+ * flash write. Provisioning flows that re-send the whole config can
+ * call this freely without wearing the sector.
+ *
+ * Genuine changes modify the in-RAM config, bump config_version once,
+ * mark it dirty, and return immediately — the background committer task
+ * performs the flash erase+program after FS_COMMIT_DELAY_MS, coalescing
+ * bursts of updates into one write. Callers that need durability before
+ * proceeding use fs_manager_flush().
+ *
+ * Falls back to a synchronous save if the committer is not running
+ * (pre-scheduler, or task creation failed).
  *
  * @param blink_delay_ms      New blink delay (0 = no change)
  * @param log_level           New log level (0xFF = no change)
  * @param telemetry_interval  New telemetry interval (0 = no change)
- * @return true on success
+ * @return true on success (update accepted or nothing changed; flash
+ *         commit may be pending)
  */
 bool fs_manager_update_config(uint32_t blink_delay_ms,
                               uint8_t  log_level,
                               uint32_t telemetry_interval);
 
+/**
+ * @brief Start the background flash-commit task.
+ *
+ * Call from main() before vTaskStartScheduler(). Until the task runs,
+ * fs_manager_update_config() saves synchronously.
+ *
+ * @return true if the task was created
+ */
+bool fs_manager_start_committer(void);
+
+/**
+ * @brief Block until any pending config update is on flash.
+ *
+ * For callers that must not proceed before durability (e.g. just
+ * before a deliberate reboot). Performs the save inline if the
+ * committer has not gotten to it yet.
+ *
+ * ⚠️ Do NOT call from ISR context.
+ *
+ * @return true if the config is clean on flash
+ */
+bool fs_manager_flush(void);
+
+/**
+ * @brief Export the current configuration as a JSON string.
+ *
+ * JSON is no longer the storage format — this exists for host tooling
+ * (config_sync.py) and diagnostics. Caller must mem_pool_free() the
+ * returned string (cJSON allocates through the pool hooks).
+ *
+ * @return JSON string, or NULL on allocation failure
+ */
+char *fs_manager_export_json(void);
+
 #endif /* FS_MANAGER_H */
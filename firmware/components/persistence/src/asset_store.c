@@ -0,0 +1,175 @@
+/**
+ * @file asset_store.c
+ * @brief BB4: Zero-copy XIP asset store — raw-flash region reader.
+ *
+ * Everything here is a read through the memory-mapped XIP window; the
+ * module never programs flash and never allocates. The only RAM cost
+ * is two 32-bit validity bitmasks for the lazy per-asset CRC cache.
+ *
+ * The region image is produced by tools/assets/pack_assets.py and
+ * flashed at FS_ASSET_REGION_OFFSET (see fs_config.h for the map).
+ */
+
+#include "asset_store.h"
+#include "fs_config.h"
+#include "pico/stdlib.h"
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * XIP Access
+ * ========================================================================= */
+
+/** XIP (Execute-In-Place) base address for memory-mapped flash access. */
+#define XIP_BASE_ADDR   0x10000000u
+
+/** Region start in the XIP window. */
+#define ASSET_REGION_BASE \
+    ((const uint8_t *)(XIP_BASE_ADDR + FS_ASSET_REGION_OFFSET))
+
+/* =========================================================================
+ * Module State
+ * ========================================================================= */
+
+/** Validated index header (copied — 16 bytes — so a later region
+ *  reflash mid-run cannot change count under us). */
+static asset_index_t s_index;
+
+/** Entry table in XIP (NULL until init validates the index). */
+static const asset_entry_t *s_entries = NULL;
+
+/** Bit n set: entry n's payload CRC has been checked. */
+static volatile uint32_t s_checked_mask;
+
+/** Bit n set: entry n's payload CRC matched. */
+static volatile uint32_t s_valid_mask;
+
+/* =========================================================================
+ * CRC32 (IEEE 802.3, reflected, poly 0xEDB88320)
+ *
+ * Bitwise, table-free — runs once per asset per boot, from XIP, where
+ * a 1KB lookup table would cost more flash than it saves time.
+ * ========================================================================= */
+
+static uint32_t _crc32(const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (unsigned bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+bool asset_store_init(void) {
+    memcpy(&s_index, ASSET_REGION_BASE, sizeof(s_index));
+
+    if (s_index.magic == 0xFFFFFFFFu) {
+        /* Erased region — no asset image flashed. Normal, stay quiet. */
+        return false;
+    }
+
+    if (s_index.magic != ASSET_STORE_MAGIC) {
+        printf("[asset_store] Bad magic: 0x%08lx\n",
+               (unsigned long)s_index.magic);
+        return false;
+    }
+
+    if (s_index.version != ASSET_STORE_VERSION) {
+        printf("[asset_store] Version %lu != %lu, ignoring region\n",
+               (unsigned long)s_index.version,
+               (unsigned long)ASSET_STORE_VERSION);
+        return false;
+    }
+
+    if (s_index.count == 0 || s_index.count > ASSET_STORE_MAX_ASSETS) {
+        printf("[asset_store] Bad asset count: %lu\n",
+               (unsigned long)s_index.count);
+        return false;
+    }
+
+    const asset_entry_t *entries =
+        (const asset_entry_t *)(ASSET_REGION_BASE + sizeof(asset_index_t));
+    uint32_t crc = _crc32(entries, s_index.count * sizeof(asset_entry_t));
+    if (crc != s_index.index_crc) {
+        printf("[asset_store] Index CRC mismatch: 0x%08lx != 0x%08lx\n",
+               (unsigned long)crc, (unsigned long)s_index.index_crc);
+        return false;
+    }
+
+    /* Bounds-check every entry once, so asset_store_get() never has to
+     * worry about a pointer escaping the region. */
+    for (uint32_t i = 0; i < s_index.count; i++) {
+        uint32_t end = entries[i].offset + entries[i].length;
+        if (entries[i].offset < sizeof(asset_index_t) ||
+            end < entries[i].offset ||           /* Overflow */
+            end > FS_ASSET_REGION_SIZE) {
+            printf("[asset_store] Entry %lu out of bounds, ignoring region\n",
+                   (unsigned long)i);
+            return false;
+        }
+    }
+
+    s_entries = entries;
+    s_checked_mask = 0;
+    s_valid_mask = 0;
+
+    printf("[asset_store] %lu asset(s) indexed, region %uKB @ 0x%08lx\n",
+           (unsigned long)s_index.count,
+           (unsigned)(FS_ASSET_REGION_SIZE / 1024),
+           (unsigned long)(XIP_BASE_ADDR + FS_ASSET_REGION_OFFSET));
+    return true;
+}
+
+bool asset_store_get(const char *name, const void **data, uint32_t *length) {
+    if (s_entries == NULL || name == NULL) return false;
+
+    for (uint32_t i = 0; i < s_index.count; i++) {
+        if (strncmp(name, s_entries[i].name, ASSET_NAME_MAX) != 0) {
+            continue;
+        }
+
+        uint32_t bit = 1u << i;
+        if (!(s_checked_mask & bit)) {
+            /* First lookup — verify the payload in place. Two cores
+             * racing here both compute the same CRC; the double check
+             * is wasted work, not a hazard. Set valid BEFORE checked
+             * so a reader never sees checked-but-unvalidated. */
+            uint32_t crc = _crc32(ASSET_REGION_BASE + s_entries[i].offset,
+                                  s_entries[i].length);
+            if (crc == s_entries[i].crc32) {
+                s_valid_mask |= bit;
+            } else {
+                printf("[asset_store] '%s' CRC mismatch: 0x%08lx != 0x%08lx\n",
+                       s_entries[i].name, (unsigned long)crc,
+                       (unsigned long)s_entries[i].crc32);
+            }
+            s_checked_mask |= bit;
+        }
+
+        if (!(s_valid_mask & bit)) {
+            return false;   /* Known-corrupt asset */
+        }
+
+        if (data)   *data   = ASSET_REGION_BASE + s_entries[i].offset;
+        if (length) *length = s_entries[i].length;
+        return true;
+    }
+
+    return false;   /* Not in the index */
+}
+
+uint32_t asset_store_count(void) {
+    return (s_entries != NULL) ? s_index.count : 0;
+}
+
+const asset_entry_t *asset_store_entry(uint32_t index) {
+    if (s_entries == NULL || index >= s_index.count) return NULL;
+    return &s_entries[index];
+}
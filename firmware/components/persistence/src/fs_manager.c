@@ -1,16 +1,22 @@
 /**
  * @file fs_manager.c
- * @brief BB4: Persistent configuration manager — LittleFS + cJSON.
+ * @brief BB4: Persistent configuration manager — LittleFS, binary blob.
  *
  * Manages the LittleFS filesystem lifecycle (mount, format, unmount)
- * and provides JSON-based configuration serialization using cJSON.
+ * and persists the configuration as a packed binary blob (magic +
+ * format version + app_config_t + CRC32). Load is one lfs_file_read
+ * into a stack struct — no malloc, no parser on the boot path.
+ *
+ * cJSON remains only as the import path: if host tooling drops a
+ * /config/app.json, it is parsed once at boot, merged, persisted as
+ * binary, and the JSON file removed.
  *
  * Boot sequence:
  *   1. Try to mount the existing filesystem
  *   2. If mount fails → format → mount again
- *   3. Try to read /config/app.json
- *   4. If read fails → write default config
- *   5. Parse JSON → populate in-RAM config struct
+ *   3. If /config/app.json exists → import JSON, save binary, delete it
+ *   4. Else read /config/app.bin (validate magic/version/CRC)
+ *   5. If neither valid → write default binary config
  */
 
 #include "pico/stdlib.h"    /* Platform setup — must be first */
@@ -18,8 +24,12 @@
 #include "fs_config.h"
 #include "lfs.h"
 #include "cJSON.h"
+#include "mem_pool.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
 #include <stdio.h>
-#include <stdlib.h>  /* malloc, free */
+#include <stddef.h>  /* offsetof */
 #include <string.h>
 
 /* =========================================================================
@@ -39,6 +49,21 @@ static app_config_t s_config;
 /** Filesystem mounted flag. */
 static bool s_mounted = false;
 
+/** Set once the persisted config (or defaults) is authoritative. */
+static volatile bool s_config_ready = false;
+
+/** Single-slot config-loaded callback (lazy mount consumers). */
+static void (*s_config_callback)(const app_config_t *cfg) = NULL;
+
+/** Set when the in-RAM config differs from flash. */
+static volatile bool s_dirty = false;
+
+/** Background committer task (NULL until started). */
+static TaskHandle_t s_committer_handle = NULL;
+
+/** Serializes flash saves between committer and fs_manager_flush(). */
+static SemaphoreHandle_t s_save_mutex = NULL;
+
 /* =========================================================================
  * Default Configuration Values
  * ========================================================================= */
@@ -51,14 +76,61 @@ static const app_config_t DEFAULT_CONFIG = {
 };
 
 /* =========================================================================
- * Internal: JSON Serialization
+ * Binary Config Blob
  * ========================================================================= */
 
+/** Magic marking a valid binary config blob ("ACFG"). */
+#define CONFIG_BLOB_MAGIC       0x41434647u
+
+/** Binary format version — bump when config_blob_t layout changes.
+ *  A version mismatch at load falls back to defaults (forward
+ *  migration happens through the JSON import path). */
+#define CONFIG_BLOB_VERSION     1u
+
+/**
+ * @brief On-flash binary config layout.
+ *
+ * CRC32 covers magic, format_version, and cfg (everything before the
+ * crc32 field itself).
+ */
+typedef struct {
+    uint32_t     magic;             /**< CONFIG_BLOB_MAGIC */
+    uint32_t     format_version;    /**< CONFIG_BLOB_VERSION */
+    app_config_t cfg;               /**< The configuration payload */
+    uint32_t     crc32;             /**< CRC32 of all preceding bytes */
+} __attribute__((packed)) config_blob_t;
+
+/**
+ * @brief CRC32 (IEEE 802.3, reflected, poly 0xEDB88320), bitwise.
+ *
+ * No lookup table — runs once per boot/save over ~30 bytes, so the
+ * 1KB table is not worth its flash footprint.
+ */
+static uint32_t _crc32(const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (unsigned bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/* =========================================================================
+ * Internal: JSON Serialization (import/export path only)
+ * ========================================================================= */
+
+/** cJSON hook adapters — cJSON_Hooks wants plain malloc/free signatures. */
+static void *_pool_malloc(size_t size) { return mem_pool_alloc(size); }
+static void  _pool_free(void *ptr)     { mem_pool_free(ptr); }
+
 /**
  * @brief Serialize the config struct to a JSON string.
  *
- * Caller must free() the returned string (allocated by cJSON_Print).
- * Returns NULL on allocation failure.
+ * Caller must mem_pool_free() the returned string (cJSON allocates
+ * through the pool hooks). Returns NULL on allocation failure.
  */
 static char *_config_to_json(const app_config_t *cfg) {
     cJSON *root = cJSON_CreateObject();
@@ -131,16 +203,100 @@ static bool _ensure_config_dir(void) {
 }
 
 /**
- * @brief Read the config file from LittleFS into a string.
+ * @brief Load the binary config blob from LittleFS.
  *
- * Allocates a buffer for the file contents. Caller must free().
- * Returns NULL if the file doesn't exist or read fails.
+ * Single lfs_file_read into a stack struct — no heap allocation.
+ * Validates magic, format version, and CRC32 before accepting.
+ *
+ * @return true if cfg was populated from a valid blob
  */
-static char *_read_config_file(void) {
+static bool _load_config_binary(app_config_t *cfg) {
     lfs_file_t file;
     int err = lfs_file_open(&g_lfs, &file, FS_CONFIG_APP_PATH, LFS_O_RDONLY);
     if (err < 0) {
-        return NULL;  /* File doesn't exist — expected on first boot */
+        return false;  /* File doesn't exist — expected on first boot */
+    }
+
+    config_blob_t blob;
+    lfs_ssize_t read = lfs_file_read(&g_lfs, &file, &blob, sizeof(blob));
+    lfs_file_close(&g_lfs, &file);
+
+    if (read != (lfs_ssize_t)sizeof(blob)) {
+        printf("[fs_manager] Binary config short read: %ld/%u bytes\n",
+               (long)read, (unsigned)sizeof(blob));
+        return false;
+    }
+
+    if (blob.magic != CONFIG_BLOB_MAGIC) {
+        printf("[fs_manager] Binary config bad magic: 0x%08lx\n",
+               (unsigned long)blob.magic);
+        return false;
+    }
+
+    if (blob.format_version != CONFIG_BLOB_VERSION) {
+        printf("[fs_manager] Binary config version %lu != %lu, using defaults\n",
+               (unsigned long)blob.format_version,
+               (unsigned long)CONFIG_BLOB_VERSION);
+        return false;
+    }
+
+    uint32_t crc = _crc32(&blob, offsetof(config_blob_t, crc32));
+    if (crc != blob.crc32) {
+        printf("[fs_manager] Binary config CRC mismatch: 0x%08lx != 0x%08lx\n",
+               (unsigned long)crc, (unsigned long)blob.crc32);
+        return false;
+    }
+
+    *cfg = blob.cfg;
+    return true;
+}
+
+/**
+ * @brief Write the binary config blob to LittleFS.
+ *
+ * Uses LFS_O_CREAT | LFS_O_WRONLY | LFS_O_TRUNC for atomic overwrite.
+ * LittleFS's copy-on-write ensures power-loss resilience.
+ */
+static bool _save_config_binary(const app_config_t *cfg) {
+    config_blob_t blob = {
+        .magic          = CONFIG_BLOB_MAGIC,
+        .format_version = CONFIG_BLOB_VERSION,
+        .cfg            = *cfg,
+    };
+    blob.crc32 = _crc32(&blob, offsetof(config_blob_t, crc32));
+
+    lfs_file_t file;
+    int err = lfs_file_open(&g_lfs, &file, FS_CONFIG_APP_PATH,
+                            LFS_O_CREAT | LFS_O_WRONLY | LFS_O_TRUNC);
+    if (err < 0) {
+        printf("[fs_manager] Failed to open %s for write: %d\n",
+               FS_CONFIG_APP_PATH, err);
+        return false;
+    }
+
+    lfs_ssize_t written = lfs_file_write(&g_lfs, &file, &blob, sizeof(blob));
+    lfs_file_close(&g_lfs, &file);
+
+    if (written != (lfs_ssize_t)sizeof(blob)) {
+        printf("[fs_manager] Write error: wrote %ld/%u bytes\n",
+               (long)written, (unsigned)sizeof(blob));
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read the import JSON file from LittleFS into a string.
+ *
+ * Buffer comes from the block pools. Caller must mem_pool_free().
+ * Returns NULL if the file doesn't exist or read fails.
+ */
+static char *_read_json_file(void) {
+    lfs_file_t file;
+    int err = lfs_file_open(&g_lfs, &file, FS_CONFIG_JSON_PATH, LFS_O_RDONLY);
+    if (err < 0) {
+        return NULL;  /* No import staged — the common case */
     }
 
     lfs_ssize_t size = lfs_file_size(&g_lfs, &file);
@@ -150,7 +306,7 @@ static char *_read_config_file(void) {
     }
 
     /* +1 for null terminator */
-    char *buf = (char *)malloc(size + 1);
+    char *buf = (char *)mem_pool_alloc(size + 1);
     if (!buf) {
         lfs_file_close(&g_lfs, &file);
         return NULL;
@@ -160,7 +316,7 @@ static char *_read_config_file(void) {
     lfs_file_close(&g_lfs, &file);
 
     if (read != size) {
-        free(buf);
+        mem_pool_free(buf);
         return NULL;
     }
 
@@ -169,42 +325,48 @@ static char *_read_config_file(void) {
 }
 
 /**
- * @brief Write a JSON string to the config file on LittleFS.
+ * @brief Import staged JSON config, persist as binary, consume the file.
  *
- * Uses LFS_O_CREAT | LFS_O_WRONLY | LFS_O_TRUNC for atomic overwrite.
- * LittleFS's copy-on-write ensures power-loss resilience.
+ * Host tooling (config_sync.py) stages /config/app.json; we parse it
+ * once, merge into cfg, save the binary blob, and delete the JSON so
+ * the next boot takes the zero-allocation binary path again.
+ *
+ * @return true if a JSON import was performed
  */
-static bool _write_config_file(const char *json_str) {
-    lfs_file_t file;
-    int err = lfs_file_open(&g_lfs, &file, FS_CONFIG_APP_PATH,
-                            LFS_O_CREAT | LFS_O_WRONLY | LFS_O_TRUNC);
-    if (err < 0) {
-        printf("[fs_manager] Failed to open %s for write: %d\n",
-               FS_CONFIG_APP_PATH, err);
-        return false;
-    }
+static bool _import_json_config(app_config_t *cfg) {
+    char *json_str = _read_json_file();
+    if (!json_str) return false;
 
-    lfs_ssize_t len = strlen(json_str);
-    lfs_ssize_t written = lfs_file_write(&g_lfs, &file, json_str, len);
-    lfs_file_close(&g_lfs, &file);
+    bool ok = _json_to_config(json_str, cfg);
+    mem_pool_free(json_str);
 
-    if (written != len) {
-        printf("[fs_manager] Write error: wrote %ld/%ld bytes\n",
-               (long)written, (long)len);
+    if (!ok) {
+        printf("[fs_manager] JSON import parse failed, ignoring %s\n",
+               FS_CONFIG_JSON_PATH);
         return false;
     }
 
-    return true;
+    if (_save_config_binary(cfg)) {
+        lfs_remove(&g_lfs, FS_CONFIG_JSON_PATH);
+        printf("[fs_manager] Imported %s → %s\n",
+               FS_CONFIG_JSON_PATH, FS_CONFIG_APP_PATH);
+        return true;
+    }
+
+    return false;
 }
 
 /* =========================================================================
  * Public API
  * ========================================================================= */
 
-bool fs_manager_init(void) {
-    /* Start with default config in RAM */
-    memcpy(&s_config, &DEFAULT_CONFIG, sizeof(app_config_t));
-
+/**
+ * @brief Mount (formatting if needed) and load the persisted config.
+ *
+ * The body of the former fs_manager_init() — runs inline in eager
+ * mode, from the loader task in lazy mode.
+ */
+static bool _mount_and_load(void) {
     /* Try to mount existing filesystem */
     int err = lfs_mount(&g_lfs, &g_lfs_config);
     if (err < 0) {
@@ -235,50 +397,124 @@ bool fs_manager_init(void) {
         return false;
     }
 
-    /* Try to read existing config */
-    char *json_str = _read_config_file();
-    if (json_str) {
-        if (_json_to_config(json_str, &s_config)) {
-            printf("[fs_manager] Config loaded: v%lu, blink=%lums, log=%d, telem=%lums\n",
-                   (unsigned long)s_config.config_version,
-                   (unsigned long)s_config.blink_delay_ms,
-                   s_config.log_level,
-                   (unsigned long)s_config.telemetry_interval_ms);
-        } else {
-            printf("[fs_manager] Config parse failed, using defaults\n");
-            memcpy(&s_config, &DEFAULT_CONFIG, sizeof(app_config_t));
-        }
-        free(json_str);
+    /* JSON import (if staged by host tooling) takes precedence,
+     * otherwise the binary blob is the single boot-path read. */
+    if (_import_json_config(&s_config) ||
+        _load_config_binary(&s_config)) {
+        printf("[fs_manager] Config loaded: v%lu, blink=%lums, log=%d, telem=%lums\n",
+               (unsigned long)s_config.config_version,
+               (unsigned long)s_config.blink_delay_ms,
+               s_config.log_level,
+               (unsigned long)s_config.telemetry_interval_ms);
     } else {
-        printf("[fs_manager] No config file, writing defaults...\n");
+        printf("[fs_manager] No valid config, writing defaults...\n");
+        memcpy(&s_config, &DEFAULT_CONFIG, sizeof(app_config_t));
         if (!fs_manager_save_config()) {
             printf("[fs_manager] Failed to write default config\n");
             /* Non-fatal — config is in RAM with defaults */
         }
     }
 
+    s_config_ready = true;
+    if (s_config_callback != NULL) {
+        s_config_callback(&s_config);
+    }
+
+    /* An update that raced the background mount left the config dirty
+     * and its save failed — wake the committer now that saves work. */
+    if (s_dirty && s_committer_handle != NULL) {
+        xTaskNotifyGive(s_committer_handle);
+    }
+
     printf("[fs_manager] Init complete\n");
     return true;
 }
 
+#if FS_LAZY_MOUNT
+/**
+ * @brief One-shot loader task — mount/format/load in the background.
+ *
+ * Runs at idle+1 so a worst-case full format steals only idle time;
+ * the scheduler (and blinky) started long before flash was touched.
+ */
+static void _fs_loader_task(void *params) {
+    (void)params;
+
+    printf("[fs_manager] Background loader started\n");
+    _mount_and_load();
+    vTaskDelete(NULL);
+}
+#endif
+
+bool fs_manager_init(void) {
+    /* Route every cJSON allocation through the fixed-block pools so
+     * JSON import/export cannot fragment the FreeRTOS heap. */
+    cJSON_Hooks hooks = {
+        .malloc_fn = _pool_malloc,
+        .free_fn   = _pool_free,
+    };
+    cJSON_InitHooks(&hooks);
+
+    /* Start with default config in RAM */
+    memcpy(&s_config, &DEFAULT_CONFIG, sizeof(app_config_t));
+
+#if FS_LAZY_MOUNT
+    /* Lazy mode: defaults are live NOW; mount/format/load run from a
+     * background task once the scheduler starts. Boot no longer waits
+     * on flash health. */
+    BaseType_t ret = xTaskCreate(
+        _fs_loader_task,
+        "fs_loader",
+        FS_LOADER_STACK_SIZE,
+        NULL,
+        FS_LOADER_PRIORITY,
+        NULL
+    );
+
+    if (ret != pdPASS) {
+        printf("[fs_manager] Loader task creation failed, mounting inline\n");
+        return _mount_and_load();
+    }
+
+    printf("[fs_manager] Lazy mount: defaults active, loader deferred\n");
+    return true;
+#else
+    return _mount_and_load();
+#endif
+}
+
 const app_config_t *fs_manager_get_config(void) {
     return &s_config;
 }
 
+bool fs_manager_is_mounted(void) {
+    return s_mounted;
+}
+
+bool fs_manager_config_ready(void) {
+    return s_config_ready;
+}
+
+void fs_manager_on_config_loaded(void (*callback)(const app_config_t *cfg)) {
+    s_config_callback = callback;
+
+    /* Late registration: the load already happened — tell them now */
+    if (callback != NULL && s_config_ready) {
+        callback(&s_config);
+    }
+}
+
+char *fs_manager_export_json(void) {
+    return _config_to_json(&s_config);
+}
+
 bool fs_manager_save_config(void) {
     if (!s_mounted) {
         printf("[fs_manager] Cannot save — filesystem not mounted\n");
         return false;
     }
 
-    char *json_str = _config_to_json(&s_config);
-    if (!json_str) {
-        printf("[fs_manager] JSON serialization failed\n");
-        return false;
-    }
-
-    bool ok = _write_config_file(json_str);
-    free(json_str);
+    bool ok = _save_config_binary(&s_config);
 
     if (ok) {
         printf("[fs_manager] Config saved (v%lu)\n",
@@ -291,18 +527,129 @@ bool fs_manager_save_config(void) {
 bool fs_manager_update_config(uint32_t blink_delay_ms,
                               uint8_t  log_level,
                               uint32_t telemetry_interval) {
-    if (blink_delay_ms != 0) {
+    bool changed = false;
+
+    /* Compare before assigning — a field "updated" to the value it
+     * already holds must not dirty the config or bump the version. */
+    if (blink_delay_ms != 0 && blink_delay_ms != s_config.blink_delay_ms) {
         s_config.blink_delay_ms = blink_delay_ms;
+        changed = true;
     }
-    if (log_level != 0xFF) {
+    if (log_level != 0xFF && log_level != s_config.log_level) {
         s_config.log_level = log_level;
+        changed = true;
     }
-    if (telemetry_interval != 0) {
+    if (telemetry_interval != 0 &&
+        telemetry_interval != s_config.telemetry_interval_ms) {
         s_config.telemetry_interval_ms = telemetry_interval;
+        changed = true;
     }
 
-    /* Bump version on every update */
+    /* Nothing actually changed — no version bump, no flash traffic.
+     * Provisioning re-sends of the current config land here. */
+    if (!changed) {
+        return true;
+    }
+
+    /* Bump version once per effective update */
     s_config.config_version++;
 
-    return fs_manager_save_config();
+    /* No committer running (pre-scheduler or creation failure):
+     * fall back to the old synchronous save. */
+    if (s_committer_handle == NULL) {
+        return fs_manager_save_config();
+    }
+
+    /* Mark dirty and wake the committer — the flash stall happens in
+     * its quiet window, not here. */
+    s_dirty = true;
+    xTaskNotifyGive(s_committer_handle);
+    return true;
+}
+
+/* =========================================================================
+ * Background Flash Committer
+ * ========================================================================= */
+
+/**
+ * @brief Take the save mutex, write the config if dirty, release.
+ *
+ * Shared by the committer task and fs_manager_flush(). Clears s_dirty
+ * BEFORE writing so an update racing with the save leaves the flag set
+ * and triggers another commit rather than being lost.
+ */
+static bool _commit_if_dirty(void) {
+    bool ok = true;
+
+    xSemaphoreTake(s_save_mutex, portMAX_DELAY);
+    if (s_dirty) {
+        s_dirty = false;
+        ok = fs_manager_save_config();
+        if (!ok) {
+            s_dirty = true;  /* Retry on the next wakeup */
+        }
+    }
+    xSemaphoreGive(s_save_mutex);
+
+    return ok;
+}
+
+/**
+ * @brief Committer task — coalesces config updates into single commits.
+ *
+ * Sleeps until fs_manager_update_config() notifies it, then waits
+ * FS_COMMIT_DELAY_MS so a burst of updates lands in one erase+program
+ * cycle, then commits. The dual-core flash lockout still happens, but
+ * at idle+1 priority in a window nobody is waiting on.
+ */
+static void _fs_committer_task(void *params) {
+    (void)params;
+
+    printf("[fs_manager] Committer started, delay=%dms\n", FS_COMMIT_DELAY_MS);
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        /* Coalescing window — absorb follow-up updates */
+        vTaskDelay(pdMS_TO_TICKS(FS_COMMIT_DELAY_MS));
+        /* Clear notifications accumulated during the window */
+        ulTaskNotifyTake(pdTRUE, 0);
+
+        _commit_if_dirty();
+    }
+}
+
+bool fs_manager_start_committer(void) {
+    if (s_save_mutex == NULL) {
+        s_save_mutex = xSemaphoreCreateMutex();
+        configASSERT(s_save_mutex != NULL);
+    }
+
+    BaseType_t ret = xTaskCreate(
+        _fs_committer_task,
+        "fs_commit",
+        FS_COMMITTER_STACK_SIZE,
+        NULL,
+        FS_COMMITTER_PRIORITY,
+        &s_committer_handle
+    );
+
+    if (ret != pdPASS) {
+        printf("[fs_manager] Failed to create committer task\n");
+        s_committer_handle = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool fs_manager_flush(void) {
+    if (!s_dirty) return true;
+
+    /* Committer never started — synchronous save path */
+    if (s_committer_handle == NULL) {
+        s_dirty = false;
+        return fs_manager_save_config();
+    }
+
+    return _commit_if_dirty();
 }
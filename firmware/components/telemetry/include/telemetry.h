@@ -10,14 +10,17 @@
  *   Channel 0: Text stdio (printf) — Pico SDK default
  *   Channel 1: Binary tokenized logs (BB2)
  *   Channel 2: Binary telemetry vitals (BB4)
+ *   Channel 3: Context-switch trace stream (task_trace.h)
  *
  * Packet Format (see architecture doc Section 4):
  *   [packet_type:1][timestamp:4][free_heap:4][min_free_heap:4]
- *   [task_count:1][per_task_entry:8 × N]
+ *   [largest_free_block:4][log_bytes:4][log_dropped:4][telem_bytes:4]
+ *   [telem_dropped:4][sleep_us:4][task_count:1][per_task_entry:14 × N]
  *
  * Per-task entry:
  *   [task_number:1][state:1][priority:1][stack_hwm:2]
- *   [cpu_pct:1][runtime_counter:2]
+ *   [cpu_pct:1][runtime_counter:2][lat_max_us:2][lat_mean_us:2]
+ *   [preempt_count:2]
  */
 
 #ifndef TELEMETRY_H
@@ -35,10 +38,10 @@
 #define TELEMETRY_RTT_CHANNEL       2
 
 /** RTT up-buffer size for telemetry channel (bytes).
- *  System header (14B) + 8 tasks × 8B = 78B per packet.
- *  512B buffer holds ~6 packets before host must drain.
- *  At 500ms interval, host has ~3 seconds of buffer. */
-#define TELEMETRY_RTT_BUFFER_SIZE   512
+ *  Grown from 512B when task_entry_t went to 14 bytes: a worst-case
+ *  full snapshot (38B header + 32 × 14B) is 486B and must fit the
+ *  buffer in one write even when the host is slow to drain. */
+#define TELEMETRY_RTT_BUFFER_SIZE   1024
 
 /** RTT buffer mode — drop packet if buffer full (zero latency). */
 #define TELEMETRY_RTT_MODE          SEGGER_RTT_MODE_NO_BLOCK_SKIP
@@ -47,12 +50,101 @@
  * Packet Type Constants
  * ========================================================================= */
 
-/** System vitals packet (heap + per-task stats). */
+/** System vitals packet (heap + per-task stats) — full snapshot. */
 #define TELEMETRY_PKT_SYSTEM_VITALS 0x01
 
-/** Per-task detailed stats (BB5 extension — reserved). */
+/** Per-task delta stats — only fields that changed since the previous
+ *  cycle. Sent between full snapshots so the per-cycle cost no longer
+ *  scales with the full 14-byte entry × task count.
+ *
+ *  Layout: vitals_header_t (task_count = number of delta entries),
+ *  then per entry:
+ *    [task_number:1][change_mask:1][changed fields, task_entry_t order]
+ *  Tasks with no changed fields are omitted entirely. A task not seen
+ *  in the previous snapshot is sent with all field bits set. */
 #define TELEMETRY_PKT_TASK_STATS    0x02
 
+/** Change-mask bits for TELEMETRY_PKT_TASK_STATS entries.
+ *  Field sizes match task_entry_t (state 1B, priority 1B, stack_hwm 2B,
+ *  cpu_pct 1B, runtime_counter 2B, latency max+mean 2×2B, preempt 2B). */
+#define TELEMETRY_DELTA_STATE       (1u << 0)
+#define TELEMETRY_DELTA_PRIORITY    (1u << 1)
+#define TELEMETRY_DELTA_STACK_HWM   (1u << 2)
+#define TELEMETRY_DELTA_CPU_PCT     (1u << 3)
+#define TELEMETRY_DELTA_RUNTIME     (1u << 4)
+#define TELEMETRY_DELTA_LATENCY     (1u << 5)   /* lat_max_us + lat_mean_us */
+#define TELEMETRY_DELTA_PREEMPT     (1u << 6)
+#define TELEMETRY_DELTA_ALL         0x7Fu
+
+/** Hot-path tracepoint statistics (per-core min/max/mean per window).
+ *  Layout: [type:1][core:1][entry_count:1] then per entry
+ *  [id:1][count:4][min_us:4][max_us:4][mean_us:4].
+ *  See firmware/components/instrumentation/include/trace_points.h. */
+#define TELEMETRY_PKT_TRACE_STATS   0x03
+
+/** One-shot boot timeline — emitted on the supervisor's first cycle.
+ *  Layout: [type:1][count:1][dropped:1] then per entry
+ *  [name:8][timestamp_us:4] (absolute TIMERAWL microseconds).
+ *  See firmware/components/instrumentation/include/boot_profile.h. */
+#define TELEMETRY_PKT_BOOT_TIMELINE 0x04
+
+/** Per-core load breakdown — emitted alongside each vitals packet.
+ *  Layout: [type:1][window_us:4][flash_ops:4][flash_busy_us:4]
+ *  [core_count:1] then per core
+ *  [idle_pct:1][switches:4][irq_time_us:4][irq_count:4]
+ *  window_us is the TIMERAWL span since the previous core-load packet;
+ *  all other fields are per-window deltas. idle_pct comes from the
+ *  per-core idle tasks' runtime counters (100 = core fully idle).
+ *  flash_ops/flash_busy_us count flash_safe_op() lockouts — the only
+ *  windows where BOTH cores are frozen. irq fields are fed by the
+ *  core_load.h ISR brackets. 40 bytes for two cores. */
+#define TELEMETRY_PKT_CORE_LOAD     0x05
+
+/** Batch frame — several telemetry packets in ONE RTT write.
+ *  Layout: [type:1][entry_count:1][payload_len:2 LE] then per entry
+ *    [orig_len:2 LE][enc_len:2 LE][slot:4|method:4][enc_len bytes]
+ *  method (low nibble): 0 = raw, 1 = RLE0(raw), 2 = RLE0(XOR vs the
+ *  previous packet in the same reference slot). slot (high nibble)
+ *  names the XOR reference: 0 = vitals, 1 = task stats — the decoder
+ *  keeps the same two previous-packet buffers the firmware does.
+ *  0xB5 cannot collide with vitals headers (types stay below 0x10). */
+#define TELEMETRY_PKT_BATCH         0xB5
+
+/** Entry compression methods (batch frames). */
+#define TELEMETRY_BATCH_RAW         0
+#define TELEMETRY_BATCH_RLE0        1
+#define TELEMETRY_BATCH_XOR_RLE0    2
+
+/* =========================================================================
+ * Batching & Compression
+ * ========================================================================= */
+
+/** Accumulate packets in a RAM staging buffer and emit one framed,
+ *  compressed batch per TELEMETRY_BATCH_MAX_PACKETS packets (or when
+ *  the staging buffer fills) instead of one RTT write per packet.
+ *  Task tables barely change cycle-to-cycle, so XOR against the
+ *  previous packet of the same type followed by zero-run-length
+ *  encoding collapses snapshots to a few bytes — the 512B RTT buffer
+ *  holds 5-10× more history and the per-sample RTT header/locking
+ *  cost is amortized across the batch. Set to 0 for the legacy
+ *  one-write-per-packet path. */
+#ifndef TELEMETRY_BATCHING
+#define TELEMETRY_BATCHING          1
+#endif
+
+/** RAM staging buffer for the open batch. Must hold the worst-case
+ *  batch: MAX_PACKETS incompressible entries + 5B entry headers. */
+#define TELEMETRY_BATCH_BUFFER_SIZE 1024
+
+/** Packets per batch before an automatic flush. At 2 packets per
+ *  supervisor cycle (vitals + trace stats) this is ~4 cycles of
+ *  history per RTT write. */
+#define TELEMETRY_BATCH_MAX_PACKETS 8
+
+/** Largest single packet the batcher tracks for XOR deltas — the full
+ *  snapshot (38B header + 32 × 14B entries) plus headroom. */
+#define TELEMETRY_BATCH_MAX_PACKET  512
+
 /* =========================================================================
  * Supervisor Task Configuration
  * ========================================================================= */
@@ -67,8 +159,40 @@
 #define SUPERVISOR_PRIORITY         (tskIDLE_PRIORITY + 1)
 
 /** Maximum number of tasks the supervisor can report on.
- *  Limits the per-packet size. FreeRTOS tasks beyond this are ignored. */
-#define SUPERVISOR_MAX_TASKS        16
+ *  Limits the per-packet size. FreeRTOS tasks beyond this are ignored.
+ *  Raised from 16 once delta packets stopped the full snapshot from
+ *  being sent every cycle — a 32-task full snapshot (38 + 32×14 = 486B)
+ *  still fits the 1KB RTT buffer, and the steady-state delta packets
+ *  are a fraction of that. */
+#define SUPERVISOR_MAX_TASKS        32
+
+/** Send a full TELEMETRY_PKT_SYSTEM_VITALS snapshot every Nth cycle;
+ *  the cycles in between send TELEMETRY_PKT_TASK_STATS deltas only.
+ *  The snapshot bounds how long the host needs to resynchronize state. */
+#define SUPERVISOR_SNAPSHOT_PERIOD  10
+
+/** Floor for telemetry_set_interval() — faster sampling than this
+ *  saturates the 512B RTT buffer and starves the flusher tier. */
+#define SUPERVISOR_MIN_INTERVAL_MS  50
+
+/* =========================================================================
+ * Adaptive Backoff (host not draining RTT)
+ * ========================================================================= */
+
+/** When RTT drops appear in a sampling window (no debugger attached or
+ *  host stalled), the supervisor doubles its interval up to
+ *  SUPERVISOR_BACKOFF_MAX_MULT× and demotes runtime logging to INFO;
+ *  after SUPERVISOR_BACKOFF_RECOVERY clean windows it returns to full
+ *  rate. Set to 0 to always run at the configured interval. */
+#ifndef SUPERVISOR_ADAPTIVE_BACKOFF
+#define SUPERVISOR_ADAPTIVE_BACKOFF 1
+#endif
+
+/** Maximum interval stretch while drops persist (power of two). */
+#define SUPERVISOR_BACKOFF_MAX_MULT 8
+
+/** Consecutive drop-free windows before returning to full rate. */
+#define SUPERVISOR_BACKOFF_RECOVERY 4
 
 /* =========================================================================
  * Data Structures
@@ -82,19 +206,29 @@ typedef struct {
     uint32_t timestamp;         /**< xTaskGetTickCount() */
     uint32_t free_heap;         /**< xPortGetFreeHeapSize() */
     uint32_t min_free_heap;     /**< xPortGetMinimumEverFreeHeapSize() */
+    uint32_t largest_free_block; /**< Biggest single heap_4 free block —
+                                      free_heap minus this = fragmentation */
+    uint32_t log_bytes;         /**< Log bytes flushed to RTT ch1 (cumulative) */
+    uint32_t log_dropped;       /**< Log packets lost: ring full or RTT skip */
+    uint32_t telem_bytes;       /**< Telemetry bytes written to RTT ch2 */
+    uint32_t telem_dropped;     /**< Telemetry packets skipped (RTT full) */
+    uint32_t sleep_us;          /**< WFI doze time, both cores (cumulative) */
     uint8_t  task_count;        /**< Number of per-task entries */
 } __attribute__((packed)) vitals_header_t;
 
 /**
- * @brief Per-task telemetry entry — 8 bytes each.
+ * @brief Per-task telemetry entry — 14 bytes each.
  */
 typedef struct {
     uint8_t  task_number;       /**< FreeRTOS task number */
     uint8_t  state;             /**< 0=Run,1=Ready,2=Blocked,3=Suspended,4=Deleted */
     uint8_t  priority;          /**< Current priority */
     uint16_t stack_hwm;         /**< Stack high water mark (words remaining) */
-    uint8_t  cpu_pct;           /**< CPU usage 0-100% */
+    uint8_t  cpu_pct;           /**< CPU usage 0-100% (64-bit wrap-free deltas) */
     uint16_t runtime_counter;   /**< Truncated runtime (ms, wrapping) */
+    uint16_t lat_max_us;        /**< Max ready→running latency this window (µs, clamped) */
+    uint16_t lat_mean_us;       /**< Mean ready→running latency this window (µs, clamped) */
+    uint16_t preempt_count;     /**< Preemptions this window (lost CPU while ready) */
 } __attribute__((packed)) task_entry_t;
 
 /* =========================================================================
@@ -125,4 +259,53 @@ void telemetry_init(void);
  */
 bool telemetry_start_supervisor(uint32_t interval_ms);
 
+/**
+ * @brief Force the open batch out to RTT Channel 2.
+ *
+ * No-op when TELEMETRY_BATCHING is 0 or the batch is empty. Packets
+ * otherwise leave the device when the batch fills (~4 supervisor
+ * cycles) — call this before a deliberate reboot or from a host
+ * "drain now" command so the tail is not lost.
+ */
+void telemetry_flush(void);
+
+/**
+ * @brief Cumulative bytes successfully written to RTT Channel 2.
+ */
+uint32_t telemetry_bytes_written(void);
+
+/**
+ * @brief Cumulative packets dropped because the Channel 2 buffer was
+ *        full (host not draining).
+ */
+uint32_t telemetry_packets_dropped(void);
+
+/**
+ * @brief Change the supervisor's sampling interval at runtime.
+ *
+ * Takes effect on the supervisor's next wakeup (worst case one old
+ * interval late — the sleep in progress is not aborted). Clamped to
+ * SUPERVISOR_MIN_INTERVAL_MS; 0 restores the 500ms default. Safe from
+ * any task (single aligned word write). Used by the RTT command
+ * channel so tuning sessions don't need a reboot.
+ */
+void telemetry_set_interval(uint32_t interval_ms);
+
+/**
+ * @brief Currently active supervisor sampling interval (ms).
+ *
+ * Before the adaptive backoff multiplier, if any.
+ */
+uint32_t telemetry_get_interval(void);
+
+/**
+ * @brief Request a full vitals snapshot on the next supervisor cycle.
+ *
+ * The next packet is forced to TELEMETRY_PKT_SYSTEM_VITALS (instead of
+ * a delta) and the batch is flushed right after it, so complete state
+ * reaches the host within one sampling interval. One-shot diagnostics
+ * hook for the RTT command channel.
+ */
+void telemetry_request_snapshot(void);
+
 #endif /* TELEMETRY_H */
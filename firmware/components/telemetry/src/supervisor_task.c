@@ -17,19 +17,43 @@
  * CPU% calculation:
  *   Each task's CPU% is calculated as a delta since the last sample:
  *   cpu_pct = (task_runtime_delta / total_runtime_delta) * 100
- *   This avoids accumulation errors from the 32-bit wrapping counter.
+ *   Runtimes come from sched_stats (64-bit, accumulated in the context
+ *   switch hooks) rather than the TCB's ulRunTimeCounter, which wraps
+ *   at ~71 minutes and silently corrupts the first delta after a wrap.
+ *
+ * Scheduling latency / preemption:
+ *   sched_stats also measures ready→running latency and counts
+ *   preemptions per task; the supervisor reports per-window values
+ *   (max, mean, count) in the three trailing task_entry_t fields.
  */
 
 #include "telemetry.h"
+#include "trace_points.h"      /* Hot-path tracepoint stats emission */
+#include "boot_profile.h"      /* One-shot boot timeline emission */
+#include "task_trace.h"        /* Per-core context-switch counters */
+#include "core_load.h"         /* Per-core ISR time accumulators */
+#include "sched_stats.h"       /* 64-bit runtimes + scheduling latency */
 #include "watchdog_manager.h"  /* BB5: Cooperative watchdog check-in */
+#include "ai_log.h"            /* Runtime level gate (adaptive backoff) */
+#include "log_ring.h"          /* Log channel byte/drop counters */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "hardware/timer.h"    /* timer_hw->timerawl — window measurement */
 #include <string.h>
 #include <stdio.h>
 
 /* Forward declaration — defined in telemetry_driver.c */
 extern unsigned telemetry_write_packet(const void *data, unsigned length);
 
+/* Flash lockout counters — firmware/core/hardware/flash_safe.c (extern
+ * declarations, same pattern as telemetry_write_packet above, to avoid
+ * pulling the core HAL into this component's include path). */
+extern uint32_t flash_safe_op_count(void);
+extern uint32_t flash_safe_busy_us(void);
+
+/* WFI doze accounting — firmware/core/hardware/power_profile.c */
+extern uint32_t power_profile_sleep_us(unsigned core);
+
 /* =========================================================================
  * Module State
  * ========================================================================= */
@@ -37,49 +61,231 @@ extern unsigned telemetry_write_packet(const void *data, unsigned length);
 /** Default sampling interval if not specified. */
 #define DEFAULT_INTERVAL_MS     500
 
-/** Previous runtime counters for CPU% delta calculation. */
-static uint32_t s_prev_runtime[SUPERVISOR_MAX_TASKS];
-static uint32_t s_prev_total_runtime;
+/** Previous 64-bit runtimes for CPU% delta calculation, indexed by the
+ *  kernel's never-reused xTaskNumber. Tasks numbered beyond the array
+ *  are skipped rather than modulo-aliased onto an unrelated slot. */
+static uint64_t s_prev_runtime[SUPERVISOR_MAX_TASKS];
+
+/** Previous cumulative latency/preemption counters for the per-window
+ *  values in task_entry_t, indexed like s_prev_runtime. */
+static uint32_t s_prev_lat_sum[SUPERVISOR_MAX_TASKS];
+static uint32_t s_prev_lat_count[SUPERVISOR_MAX_TASKS];
+static uint32_t s_prev_preempt[SUPERVISOR_MAX_TASKS];
+
+/** Previous cycle's encoded entries for delta packets, indexed like
+ *  s_prev_runtime. */
+static task_entry_t s_prev_entry[SUPERVISOR_MAX_TASKS];
+
+/** Bitmask of valid s_prev_entry slots — cleared on each full snapshot
+ *  so stale tasks cannot poison deltas across a snapshot boundary. */
+static uint32_t s_prev_valid;
+
+/** Cycle counter — every SUPERVISOR_SNAPSHOT_PERIOD'th cycle sends a
+ *  full snapshot instead of a delta. */
+static uint32_t s_cycle;
 
 /** Task handle for the supervisor (allows external control). */
 static TaskHandle_t s_supervisor_handle = NULL;
 
+/** Active sampling interval — written by telemetry_set_interval() from
+ *  any task, read by the supervisor each cycle. Single aligned word,
+ *  so plain volatile access is atomic on M0+. */
+static volatile uint32_t s_interval_ms = DEFAULT_INTERVAL_MS;
+
+/** One-shot: force the next vitals packet to be a full snapshot and
+ *  flush the batch behind it (telemetry_request_snapshot()). */
+static volatile bool s_snapshot_request;
+
 /* =========================================================================
  * Supervisor Task Implementation
  * ========================================================================= */
 
 /**
- * @brief Build and send a system vitals packet.
+ * @brief Encode one delta entry: [task_number][change_mask][changed fields].
+ *
+ * Compares the current entry against the previous cycle's copy and
+ * appends only the fields that differ (task_entry_t field order).
+ * A task with no valid previous entry is sent with all field bits set.
+ *
+ * @return Bytes appended to out (0 if nothing changed)
+ */
+static unsigned _encode_delta_entry(const task_entry_t *cur, uint8_t task_idx,
+                                    uint8_t *out) {
+    uint8_t mask = 0;
+
+    if (s_prev_valid & (1u << task_idx)) {
+        const task_entry_t *prev = &s_prev_entry[task_idx];
+        if (cur->state != prev->state)                     mask |= TELEMETRY_DELTA_STATE;
+        if (cur->priority != prev->priority)               mask |= TELEMETRY_DELTA_PRIORITY;
+        if (cur->stack_hwm != prev->stack_hwm)             mask |= TELEMETRY_DELTA_STACK_HWM;
+        if (cur->cpu_pct != prev->cpu_pct)                 mask |= TELEMETRY_DELTA_CPU_PCT;
+        if (cur->runtime_counter != prev->runtime_counter) mask |= TELEMETRY_DELTA_RUNTIME;
+        if (cur->lat_max_us != prev->lat_max_us ||
+            cur->lat_mean_us != prev->lat_mean_us)         mask |= TELEMETRY_DELTA_LATENCY;
+        if (cur->preempt_count != prev->preempt_count)     mask |= TELEMETRY_DELTA_PREEMPT;
+    } else {
+        mask = TELEMETRY_DELTA_ALL;  /* New task — send everything */
+    }
+
+    if (mask == 0) return 0;  /* Idle/blocked task, nothing moved — omit */
+
+    unsigned pos = 0;
+    out[pos++] = cur->task_number;
+    out[pos++] = mask;
+    if (mask & TELEMETRY_DELTA_STATE)     out[pos++] = cur->state;
+    if (mask & TELEMETRY_DELTA_PRIORITY)  out[pos++] = cur->priority;
+    if (mask & TELEMETRY_DELTA_STACK_HWM) {
+        memcpy(&out[pos], &cur->stack_hwm, 2);
+        pos += 2;
+    }
+    if (mask & TELEMETRY_DELTA_CPU_PCT)   out[pos++] = cur->cpu_pct;
+    if (mask & TELEMETRY_DELTA_RUNTIME) {
+        memcpy(&out[pos], &cur->runtime_counter, 2);
+        pos += 2;
+    }
+    if (mask & TELEMETRY_DELTA_LATENCY) {
+        memcpy(&out[pos], &cur->lat_max_us, 2);
+        pos += 2;
+        memcpy(&out[pos], &cur->lat_mean_us, 2);
+        pos += 2;
+    }
+    if (mask & TELEMETRY_DELTA_PREEMPT) {
+        memcpy(&out[pos], &cur->preempt_count, 2);
+        pos += 2;
+    }
+    return pos;
+}
+
+/**
+ * @brief Build and send the per-core load packet (TELEMETRY_PKT_CORE_LOAD).
+ *
+ * All fields are deltas over the window since the previous emission,
+ * measured against cumulative counters the producers keep — the same
+ * pattern as the CPU% calculation above. Critical-section cost is
+ * reported as flash lockout count/time: flash_safe_op() windows are the
+ * only events in this firmware that freeze BOTH cores, and the kernel's
+ * own short critical sections are not hookable without patching it.
+ *
+ * @param idle_runtime  Current cumulative idle-task runtime per core
+ *                      (μs), gathered from the vitals task walk
+ */
+static void _send_core_load_packet(const uint32_t idle_runtime[2]) {
+    static uint32_t s_prev_ts;
+    static uint32_t s_prev_idle[2];
+    static uint32_t s_prev_switch[2];
+    static uint32_t s_prev_irq_us[2];
+    static uint32_t s_prev_irq_count[2];
+    static uint32_t s_prev_flash_ops;
+    static uint32_t s_prev_flash_us;
+
+    uint32_t now = timer_hw->timerawl;
+    uint32_t window_us = now - s_prev_ts;   /* Unsigned wrap-safe */
+    s_prev_ts = now;
+    if (window_us == 0) window_us = 1;
+
+    uint32_t flash_ops = flash_safe_op_count();
+    uint32_t flash_us  = flash_safe_busy_us();
+
+    /* [type:1][window_us:4][flash_ops:4][flash_busy_us:4][core_count:1]
+     * + 2 × [idle_pct:1][switches:4][irq_time_us:4][irq_count:4] */
+    uint8_t packet[14 + 2 * 13];
+    unsigned pos = 0;
+
+    packet[pos++] = TELEMETRY_PKT_CORE_LOAD;
+    memcpy(&packet[pos], &window_us, 4);
+    pos += 4;
+    uint32_t flash_ops_delta = flash_ops - s_prev_flash_ops;
+    uint32_t flash_us_delta  = flash_us - s_prev_flash_us;
+    memcpy(&packet[pos], &flash_ops_delta, 4);
+    pos += 4;
+    memcpy(&packet[pos], &flash_us_delta, 4);
+    pos += 4;
+    packet[pos++] = 2;  /* core_count */
+
+    for (unsigned core = 0; core < 2; core++) {
+        uint32_t idle_delta = idle_runtime[core] - s_prev_idle[core];
+        uint32_t idle_pct = (idle_delta * 100u) / window_us;
+        if (idle_pct > 100) idle_pct = 100;
+        packet[pos++] = (uint8_t)idle_pct;
+
+        uint32_t switches = task_trace_switch_count(core);
+        uint32_t irq_us   = core_load_irq_time_us(core);
+        uint32_t irq_cnt  = core_load_irq_count(core);
+        uint32_t sw_delta  = switches - s_prev_switch[core];
+        uint32_t us_delta  = irq_us - s_prev_irq_us[core];
+        uint32_t cnt_delta = irq_cnt - s_prev_irq_count[core];
+        memcpy(&packet[pos], &sw_delta, 4);
+        pos += 4;
+        memcpy(&packet[pos], &us_delta, 4);
+        pos += 4;
+        memcpy(&packet[pos], &cnt_delta, 4);
+        pos += 4;
+
+        s_prev_idle[core]      = idle_runtime[core];
+        s_prev_switch[core]    = switches;
+        s_prev_irq_us[core]    = irq_us;
+        s_prev_irq_count[core] = irq_cnt;
+    }
+
+    s_prev_flash_ops = flash_ops;
+    s_prev_flash_us  = flash_us;
+
+    telemetry_write_packet(packet, pos);
+}
+
+/**
+ * @brief Build and send a vitals packet — full snapshot or delta.
  *
- * Packet layout:
- *   [header: 14 bytes] [task_entry: 8 bytes × N]
+ * Every SUPERVISOR_SNAPSHOT_PERIOD'th cycle sends the full
+ * TELEMETRY_PKT_SYSTEM_VITALS packet (header + 14B × N tasks); the
+ * cycles in between send TELEMETRY_PKT_TASK_STATS with only the
+ * per-task fields that changed, so steady-state cost no longer scales
+ * with the task count and the 1KB RTT buffer supports 32 tasks.
  *
- * Maximum packet size: 14 + (16 × 8) = 142 bytes.
- * Fits comfortably in the 512-byte RTT buffer.
+ * Maximum packet size: 38 + (32 × 14) = 486 bytes (full snapshot).
  */
 static void _send_vitals_packet(void) {
-    /* Stack-allocated buffer for the entire packet.
-     * Max: 14B header + 16 tasks × 8B = 142B */
-    uint8_t packet[sizeof(vitals_header_t) + SUPERVISOR_MAX_TASKS * sizeof(task_entry_t)];
+    /* Worst-case delta (all fields changed) is 15B/task — one byte more
+     * than a full entry — but that only happens on the cycle after a
+     * snapshot reset, and the snapshot itself is the larger packet. */
+    uint8_t packet[sizeof(vitals_header_t) +
+                   SUPERVISOR_MAX_TASKS * (sizeof(task_entry_t) + 1)];
     unsigned pos = 0;
 
+    bool diag_request = s_snapshot_request;
+    bool full_snapshot = (s_cycle % SUPERVISOR_SNAPSHOT_PERIOD) == 0 ||
+                         diag_request;
+    s_cycle++;
+
     /* --- System-level metrics --- */
+    /* heap_4 free-list walk — free_heap vs largest block is the
+     * fragmentation signal (equal means one contiguous region). */
+    HeapStats_t heap_stats;
+    vPortGetHeapStats(&heap_stats);
+
     vitals_header_t header = {
-        .packet_type  = TELEMETRY_PKT_SYSTEM_VITALS,
+        .packet_type  = full_snapshot ? TELEMETRY_PKT_SYSTEM_VITALS
+                                      : TELEMETRY_PKT_TASK_STATS,
         .timestamp    = (uint32_t)xTaskGetTickCount(),
-        .free_heap    = (uint32_t)xPortGetFreeHeapSize(),
-        .min_free_heap = (uint32_t)xPortGetMinimumEverFreeHeapSize(),
+        .free_heap    = (uint32_t)heap_stats.xAvailableHeapSpaceInBytes,
+        .min_free_heap = (uint32_t)heap_stats.xMinimumEverFreeBytesRemaining,
+        .largest_free_block =
+            (uint32_t)heap_stats.xSizeOfLargestFreeBlockInBytes,
+        .log_bytes    = log_ring_bytes_flushed(),
+        .log_dropped  = log_ring_dropped(),
+        .telem_bytes  = telemetry_bytes_written(),
+        .telem_dropped = telemetry_packets_dropped(),
+        .sleep_us     = power_profile_sleep_us(0) + power_profile_sleep_us(1),
         .task_count   = 0,  /* Filled in below */
     };
 
     /* --- Per-task metrics via uxTaskGetSystemState() --- */
     TaskStatus_t task_status_array[SUPERVISOR_MAX_TASKS];
-    uint32_t total_runtime;
 
     UBaseType_t task_count = uxTaskGetSystemState(
         task_status_array,
         SUPERVISOR_MAX_TASKS,
-        &total_runtime
+        NULL  /* Total runtime derived from the 64-bit counters below */
     );
 
     /* Clamp to max reportable tasks */
@@ -87,30 +293,71 @@ static void _send_vitals_packet(void) {
         task_count = SUPERVISOR_MAX_TASKS;
     }
 
-    header.task_count = (uint8_t)task_count;
+    pos = sizeof(header);  /* Header written last, once counts are known */
 
-    /* Copy header to packet */
-    memcpy(&packet[pos], &header, sizeof(header));
-    pos += sizeof(header);
-
-    /* Calculate total runtime delta for CPU% */
-    uint32_t total_delta = total_runtime - s_prev_total_runtime;
+    /* Pre-pass: sample each task's 64-bit runtime once (seqlock read in
+     * sched_stats) and sum the deltas — the CPU% denominator. */
+    uint64_t runtime_now[SUPERVISOR_MAX_TASKS];
+    uint64_t total_delta = 0;
+    for (UBaseType_t i = 0; i < task_count; i++) {
+        unsigned tn = (unsigned)task_status_array[i].xTaskNumber;
+        runtime_now[i] = sched_stats_runtime_us(tn);
+        if (tn < SUPERVISOR_MAX_TASKS) {
+            total_delta += runtime_now[i] - s_prev_runtime[tn];
+        }
+    }
     if (total_delta == 0) total_delta = 1;  /* Avoid division by zero */
 
+    if (full_snapshot) {
+        /* Snapshot resets the delta baseline — forget stale tasks */
+        s_prev_valid = 0;
+    }
+
+    /* Cumulative idle runtime per core for the core-load packet.
+     * Static so a cycle where the clamp drops an idle task keeps the
+     * last seen value instead of resetting the delta baseline. */
+    static uint32_t s_idle_runtime[2];
+
     /* --- Encode per-task entries --- */
+    uint8_t entry_count = 0;
     for (UBaseType_t i = 0; i < task_count; i++) {
         TaskStatus_t *ts = &task_status_array[i];
 
-        /* CPU% as delta since last sample */
-        uint8_t cpu_pct = 0;
-        uint8_t task_idx = (uint8_t)(ts->xTaskNumber % SUPERVISOR_MAX_TASKS);
-
-        uint32_t task_delta = ts->ulRunTimeCounter - s_prev_runtime[task_idx];
-        cpu_pct = (uint8_t)((task_delta * 100) / total_delta);
+        /* FreeRTOS SMP idle tasks are "IDLE0"/"IDLE1" — the trailing
+         * digit is the core the task is pinned to. */
+        if (strncmp(ts->pcTaskName, "IDLE", 4) == 0) {
+            unsigned core = (ts->pcTaskName[4] == '1') ? 1 : 0;
+            s_idle_runtime[core] = ts->ulRunTimeCounter;
+        }
+
+        /* A task numbered beyond the slot arrays has no delta baseline
+         * — skip it outright instead of modulo-aliasing it onto another
+         * task's slot and corrupting both histories. */
+        unsigned tn = (unsigned)ts->xTaskNumber;
+        if (tn >= SUPERVISOR_MAX_TASKS) continue;
+        uint8_t task_idx = (uint8_t)tn;
+
+        /* CPU% as 64-bit delta since last sample — wrap-free */
+        uint64_t task_delta = runtime_now[i] - s_prev_runtime[task_idx];
+        uint8_t cpu_pct = (uint8_t)((task_delta * 100u) / total_delta);
         if (cpu_pct > 100) cpu_pct = 100;
-
-        /* Store current runtime for next delta */
-        s_prev_runtime[task_idx] = ts->ulRunTimeCounter;
+        s_prev_runtime[task_idx] = runtime_now[i];
+
+        /* Per-window latency/preemption values: deltas against the
+         * cumulative counters sched_stats keeps, same pattern as CPU%.
+         * The max is read-and-clear in sched_stats, so no prev needed. */
+        uint32_t lat_sum   = sched_stats_latency_sum_us(tn);
+        uint32_t lat_count = sched_stats_latency_count(tn);
+        uint32_t preempts  = sched_stats_preempt_count(tn);
+        uint32_t lat_dsum  = lat_sum - s_prev_lat_sum[task_idx];
+        uint32_t lat_dcnt  = lat_count - s_prev_lat_count[task_idx];
+        uint32_t preempt_d = preempts - s_prev_preempt[task_idx];
+        s_prev_lat_sum[task_idx]   = lat_sum;
+        s_prev_lat_count[task_idx] = lat_count;
+        s_prev_preempt[task_idx]   = preempts;
+
+        uint32_t lat_max  = sched_stats_latency_max_take(tn);
+        uint32_t lat_mean = (lat_dcnt > 0) ? (lat_dsum / lat_dcnt) : 0;
 
         task_entry_t entry = {
             .task_number     = (uint8_t)ts->xTaskNumber,
@@ -118,19 +365,90 @@ static void _send_vitals_packet(void) {
             .priority        = (uint8_t)ts->uxCurrentPriority,
             .stack_hwm       = (uint16_t)ts->usStackHighWaterMark,
             .cpu_pct         = cpu_pct,
-            .runtime_counter = (uint16_t)(ts->ulRunTimeCounter / 1000),  /* μs → ms, truncated */
+            .runtime_counter = (uint16_t)(runtime_now[i] / 1000),  /* μs → ms, truncated */
+            .lat_max_us      = (lat_max > 0xFFFFu) ? 0xFFFFu : (uint16_t)lat_max,
+            .lat_mean_us     = (lat_mean > 0xFFFFu) ? 0xFFFFu : (uint16_t)lat_mean,
+            .preempt_count   = (preempt_d > 0xFFFFu) ? 0xFFFFu : (uint16_t)preempt_d,
         };
 
-        memcpy(&packet[pos], &entry, sizeof(entry));
-        pos += sizeof(entry);
+        if (full_snapshot) {
+            memcpy(&packet[pos], &entry, sizeof(entry));
+            pos += sizeof(entry);
+            entry_count++;
+        } else {
+            unsigned added = _encode_delta_entry(&entry, task_idx, &packet[pos]);
+            if (added > 0) {
+                pos += added;
+                entry_count++;
+            }
+        }
+
+        /* Remember this cycle's entry as the next delta baseline */
+        s_prev_entry[task_idx] = entry;
+        s_prev_valid |= (1u << task_idx);
     }
 
-    /* Update total runtime for next cycle */
-    s_prev_total_runtime = total_runtime;
+    header.task_count = entry_count;
+    memcpy(&packet[0], &header, sizeof(header));
 
     /* Send packet to RTT Channel 2 */
     telemetry_write_packet(packet, pos);
+
+    /* Core-load breakdown rides along with every vitals/delta packet */
+    _send_core_load_packet(s_idle_runtime);
+
+    /* One-shot diagnostics: push the snapshot off the device now
+     * instead of waiting for the batch to fill (~4 cycles). */
+    if (diag_request) {
+        s_snapshot_request = false;
+        telemetry_flush();
+    }
+}
+
+#if SUPERVISOR_ADAPTIVE_BACKOFF
+/**
+ * @brief Stretch or restore the sampling interval based on RTT drops.
+ *
+ * Drops in the window (log channel or telemetry channel) mean the host
+ * stopped draining — every packet written from here on is wasted work
+ * plus a guaranteed drop-counter increment. Double the interval (up to
+ * SUPERVISOR_BACKOFF_MAX_MULT×) and demote runtime logging to INFO so
+ * DEBUG chatter stops churning the log rings. After
+ * SUPERVISOR_BACKOFF_RECOVERY consecutive clean windows (host came
+ * back and caught up), return to full rate and the boot-time level.
+ *
+ * @return Current interval multiplier (1 = full rate)
+ */
+static uint32_t _adaptive_backoff_update(void) {
+    static uint32_t s_prev_drops;
+    static uint32_t s_mult = 1;
+    static uint32_t s_clean_windows;
+
+    uint32_t drops = telemetry_packets_dropped() + log_ring_dropped();
+    bool dropped_this_window = (drops != s_prev_drops);
+    s_prev_drops = drops;
+
+    if (dropped_this_window) {
+        s_clean_windows = 0;
+        if (s_mult < SUPERVISOR_BACKOFF_MAX_MULT) {
+            s_mult *= 2;
+            ai_log_set_runtime_level(AI_LOG_LEVEL_INFO);
+            printf("[supervisor] RTT backpressure: interval x%lu, log level demoted\n",
+                   (unsigned long)s_mult);
+        }
+    } else if (s_mult > 1) {
+        s_clean_windows++;
+        if (s_clean_windows >= SUPERVISOR_BACKOFF_RECOVERY) {
+            s_mult = 1;
+            s_clean_windows = 0;
+            ai_log_set_runtime_level(AI_LOG_LEVEL_MIN);
+            printf("[supervisor] RTT drained, full rate restored\n");
+        }
+    }
+
+    return s_mult;
 }
+#endif /* SUPERVISOR_ADAPTIVE_BACKOFF */
 
 /**
  * @brief Supervisor task main loop.
@@ -143,6 +461,7 @@ static void _send_vitals_packet(void) {
 static void _supervisor_task(void *params) {
     uint32_t interval_ms = *(uint32_t *)params;
     if (interval_ms == 0) interval_ms = DEFAULT_INTERVAL_MS;
+    s_interval_ms = interval_ms;
 
     // BB5: Assign task number for crash identification
     vTaskSetTaskNumber(xTaskGetCurrentTaskHandle(), 2);
@@ -150,19 +469,51 @@ static void _supervisor_task(void *params) {
     printf("[supervisor] Started, interval=%lums, max_tasks=%d\n",
            (unsigned long)interval_ms, SUPERVISOR_MAX_TASKS);
 
-    /* Initialize previous runtime counters */
+    /* Initialize previous runtime counters and delta baseline */
     memset(s_prev_runtime, 0, sizeof(s_prev_runtime));
-    s_prev_total_runtime = 0;
+    memset(s_prev_lat_sum, 0, sizeof(s_prev_lat_sum));
+    memset(s_prev_lat_count, 0, sizeof(s_prev_lat_count));
+    memset(s_prev_preempt, 0, sizeof(s_prev_preempt));
+    s_prev_valid = 0;
+    s_cycle = 0;
+
+#if FAST_BOOT
+    /* Fast-boot profile: crash reporting was deferred out of the
+     * serial boot path — run it here, before the first sample. The
+     * crash ring's boot-time erase detects the running scheduler and
+     * goes through flash_safe_op. */
+    extern bool crash_reporter_init(void);
+    if (crash_reporter_init()) {
+        printf("[supervisor] Crash from previous boot detected (deferred)\n");
+    }
+#endif
+
+    /* One-shot: boot timeline recorded by main() during startup */
+    boot_profile_emit();
 
     TickType_t last_wake = xTaskGetTickCount();
 
     for (;;) {
+        TRACE_ENTER(TRACE_ID_VITALS_BUILD);
         _send_vitals_packet();
+        TRACE_EXIT(TRACE_ID_VITALS_BUILD);
+
+        /* Emit hot-path tracepoint stats for this window */
+        trace_points_emit();
 
         // BB5: Prove liveness to cooperative watchdog
         watchdog_manager_checkin(WDG_BIT_SUPERVISOR);
 
+        /* Re-read each cycle — telemetry_set_interval() may have
+         * changed it from the command channel. */
+        interval_ms = s_interval_ms;
+
+#if SUPERVISOR_ADAPTIVE_BACKOFF
+        uint32_t mult = _adaptive_backoff_update();
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(interval_ms * mult));
+#else
         vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(interval_ms));
+#endif
     }
 }
 
@@ -193,3 +544,20 @@ bool telemetry_start_supervisor(uint32_t interval_ms) {
            (unsigned long)s_interval);
     return true;
 }
+
+void telemetry_set_interval(uint32_t interval_ms) {
+    if (interval_ms == 0) interval_ms = DEFAULT_INTERVAL_MS;
+    if (interval_ms < SUPERVISOR_MIN_INTERVAL_MS) {
+        interval_ms = SUPERVISOR_MIN_INTERVAL_MS;
+    }
+    s_interval_ms = interval_ms;
+    printf("[supervisor] Interval set to %lums\n", (unsigned long)interval_ms);
+}
+
+uint32_t telemetry_get_interval(void) {
+    return s_interval_ms;
+}
+
+void telemetry_request_snapshot(void) {
+    s_snapshot_request = true;
+}
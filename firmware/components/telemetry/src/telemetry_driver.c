@@ -9,9 +9,17 @@
  *   - Static RTT buffer (not heap-allocated)
  *   - FreeRTOS taskENTER_CRITICAL() for SMP-safe writes
  *   - SEGGER_RTT_WriteNoLock() for minimal overhead
+ *
+ * With TELEMETRY_BATCHING (default on), packets are not written to RTT
+ * individually: each one is XOR-delta'd against the previous packet of
+ * the same type (task tables barely move between cycles), the result
+ * zero-run-length encoded, and appended to a RAM staging buffer. One
+ * framed RTT write ships the whole batch — see TELEMETRY_PKT_BATCH in
+ * telemetry.h for the wire format.
  */
 
 #include "telemetry.h"
+#include "ai_hot.h"          /* AI_HOT_FUNC — SRAM-resident packet builder */
 #include "SEGGER_RTT.h"
 #include "FreeRTOS.h"
 #include "task.h"
@@ -25,6 +33,11 @@
 static char s_telemetry_rtt_buffer[TELEMETRY_RTT_BUFFER_SIZE];
 static bool s_telemetry_initialized = false;
 
+/* Backpressure counters — written inside the critical section, read
+ * lock-free by the supervisor (single aligned word, atomic on M0+). */
+static volatile uint32_t s_bytes_written;
+static volatile uint32_t s_packets_dropped;
+
 /* =========================================================================
  * Initialization
  * ========================================================================= */
@@ -45,6 +58,97 @@ void telemetry_init(void) {
            TELEMETRY_RTT_CHANNEL, TELEMETRY_RTT_BUFFER_SIZE);
 }
 
+#if TELEMETRY_BATCHING
+
+/* =========================================================================
+ * Batch Staging & Compression
+ *
+ * All state below is touched only inside the critical section in
+ * telemetry_write_packet()/telemetry_flush().
+ * ========================================================================= */
+
+/** Batch frame header size: [type:1][count:1][payload_len:2]. */
+#define BATCH_FRAME_HEADER  4
+/** Per-entry header: [orig_len:2][enc_len:2][method:1]. */
+#define BATCH_ENTRY_HEADER  5
+
+/** Open batch: entries accumulate here until the flush threshold.
+ *  The first BATCH_FRAME_HEADER bytes are reserved for the frame
+ *  header, filled in at flush time — header and payload then go out
+ *  in ONE RTT write, so a NO_BLOCK_SKIP drop is all-or-nothing and
+ *  can never strand an orphan header in the channel. */
+static uint8_t s_batch[TELEMETRY_BATCH_BUFFER_SIZE];
+static unsigned s_batch_pos = BATCH_FRAME_HEADER;
+static uint8_t s_batch_count;
+
+/** Previous raw packet per tracked type (vitals / task stats) — the
+ *  XOR reference. Slot 0 = 0x01, slot 1 = 0x02. */
+static uint8_t s_prev_pkt[2][TELEMETRY_BATCH_MAX_PACKET];
+static unsigned s_prev_len[2];
+
+/** Encode scratch — XOR result and its RLE0 encoding. */
+static uint8_t s_xor_buf[TELEMETRY_BATCH_MAX_PACKET];
+static uint8_t s_enc_buf[TELEMETRY_BATCH_MAX_PACKET];
+
+/**
+ * @brief Zero-run-length encode: nonzero bytes literal, each zero run
+ *        as [0x00][run_len 1-255].
+ *
+ * Returns the encoded length, or 0 if the output would reach cap
+ * (encoding that doesn't shrink is abandoned — caller falls back).
+ */
+static unsigned AI_HOT_FUNC(_rle0_encode)(const uint8_t *in, unsigned length,
+                                          uint8_t *out, unsigned cap) {
+    unsigned i = 0, o = 0;
+    while (i < length) {
+        if (o + 2 > cap) return 0;
+        if (in[i] == 0) {
+            unsigned run = 1;
+            while (i + run < length && in[i + run] == 0 && run < 255) run++;
+            out[o++] = 0;
+            out[o++] = (uint8_t)run;
+            i += run;
+        } else {
+            out[o++] = in[i++];
+        }
+    }
+    return o;
+}
+
+/**
+ * @brief Write the staged batch as one framed RTT write and reset.
+ *
+ * Must be called inside the critical section. Drop accounting stays
+ * per-packet: a skipped batch counts every packet it carried.
+ */
+static void AI_HOT_FUNC(_flush_locked)(void) {
+    if (s_batch_count == 0) return;
+
+    /* Fill the reserved header slot at the front of the staging buffer */
+    unsigned payload = s_batch_pos - BATCH_FRAME_HEADER;
+    s_batch[0] = TELEMETRY_PKT_BATCH;
+    s_batch[1] = s_batch_count;
+    s_batch[2] = (uint8_t)(payload & 0xFF);
+    s_batch[3] = (uint8_t)(payload >> 8);
+
+    /* One contiguous write: NO_BLOCK_SKIP drops the whole frame or
+     * none of it, so a full channel can never strand a header whose
+     * payload_len would eat the next real frame on the host side. */
+    unsigned written = SEGGER_RTT_WriteNoLock(TELEMETRY_RTT_CHANNEL,
+                                              s_batch, s_batch_pos);
+    if (written > 0) {
+        s_bytes_written += written;
+    } else {
+        /* Whole frame skipped — count every packet it carried lost. */
+        s_packets_dropped += s_batch_count;
+    }
+
+    s_batch_pos = BATCH_FRAME_HEADER;
+    s_batch_count = 0;
+}
+
+#endif /* TELEMETRY_BATCHING */
+
 /* =========================================================================
  * Binary Packet Writer
  * ========================================================================= */
@@ -53,20 +157,129 @@ void telemetry_init(void) {
  * @brief Write a binary telemetry packet to RTT Channel 2.
  *
  * SMP-safe: uses FreeRTOS critical section (hardware spin locks on RP2040).
- * Non-blocking: if buffer is full, packet is silently dropped.
+ * Non-blocking: if buffer is full, packet is dropped and counted — the
+ * supervisor reports the counters in the vitals header and backs off
+ * its sampling rate when the host stops draining.
+ *
+ * Batching mode: the packet is compressed and staged; the actual RTT
+ * write happens when the batch fills (TELEMETRY_BATCH_MAX_PACKETS) or
+ * on telemetry_flush(). The return value reports the bytes accepted
+ * into the batch (== length), not bytes on the wire.
  *
  * @param data   Pointer to binary packet data
  * @param length Packet length in bytes
- * @return Number of bytes actually written (0 if buffer full or not init)
+ * @return Number of bytes accepted (0 if dropped or not init)
  */
-unsigned telemetry_write_packet(const void *data, unsigned length) {
+unsigned AI_HOT_FUNC(telemetry_write_packet)(const void *data, unsigned length) {
     if (!s_telemetry_initialized) return 0;
 
+#if TELEMETRY_BATCHING
+    const uint8_t *raw = (const uint8_t *)data;
+
+    taskENTER_CRITICAL();
+
+    /* --- Compress: XOR vs previous same-type packet, then RLE0 --- */
+    uint8_t type = raw[0];
+    int slot = (type == TELEMETRY_PKT_SYSTEM_VITALS) ? 0
+             : (type == TELEMETRY_PKT_TASK_STATS)    ? 1 : -1;
+    if (length > TELEMETRY_BATCH_MAX_PACKET) slot = -1;
+
+    const uint8_t *enc = raw;
+    unsigned enc_len = length;
+    uint8_t method = TELEMETRY_BATCH_RAW;
+
+    const uint8_t *rle_src = raw;
+    if (slot >= 0 && s_prev_len[slot] == length) {
+        for (unsigned i = 0; i < length; i++) {
+            s_xor_buf[i] = raw[i] ^ s_prev_pkt[slot][i];
+        }
+        rle_src = s_xor_buf;
+        method = TELEMETRY_BATCH_XOR_RLE0;
+    } else {
+        method = TELEMETRY_BATCH_RLE0;
+    }
+
+    unsigned rle_len = _rle0_encode(rle_src, length, s_enc_buf,
+                                    (length < sizeof(s_enc_buf))
+                                        ? length : sizeof(s_enc_buf));
+    if (rle_len > 0 && rle_len < length) {
+        enc = s_enc_buf;
+        enc_len = rle_len;
+    } else {
+        method = TELEMETRY_BATCH_RAW;   /* Didn't shrink — ship raw */
+    }
+
+    /* The XOR reference is always the RAW packet, whatever shipped */
+    if (slot >= 0) {
+        memcpy(s_prev_pkt[slot], raw, length);
+        s_prev_len[slot] = length;
+    }
+
+    /* Oversize packet (can never fit a batch entry): legacy direct
+     * write so the frame stream stays parseable. */
+    if (BATCH_FRAME_HEADER + BATCH_ENTRY_HEADER + enc_len > sizeof(s_batch)) {
+        _flush_locked();
+        unsigned written = SEGGER_RTT_WriteNoLock(TELEMETRY_RTT_CHANNEL,
+                                                  raw, length);
+        if (written > 0) s_bytes_written += written;
+        else             s_packets_dropped++;
+        taskEXIT_CRITICAL();
+        return written;
+    }
+
+    /* --- Append to the batch, flushing first if it won't fit --- */
+    if (s_batch_pos + BATCH_ENTRY_HEADER + enc_len > sizeof(s_batch) ||
+        s_batch_count == 0xFF) {
+        _flush_locked();
+    }
+
+    uint8_t *entry = &s_batch[s_batch_pos];
+    entry[0] = (uint8_t)(length & 0xFF);
+    entry[1] = (uint8_t)(length >> 8);
+    entry[2] = (uint8_t)(enc_len & 0xFF);
+    entry[3] = (uint8_t)(enc_len >> 8);
+    entry[4] = (uint8_t)(method |
+                         ((slot > 0 ? 1u : 0u) << 4));  /* XOR ref slot */
+    memcpy(&entry[BATCH_ENTRY_HEADER], enc, enc_len);
+    s_batch_pos += BATCH_ENTRY_HEADER + enc_len;
+    s_batch_count++;
+
+    if (s_batch_count >= TELEMETRY_BATCH_MAX_PACKETS) {
+        _flush_locked();
+    }
+
+    taskEXIT_CRITICAL();
+    return length;
+#else
     unsigned written;
 
     taskENTER_CRITICAL();
     written = SEGGER_RTT_WriteNoLock(TELEMETRY_RTT_CHANNEL, data, length);
+    /* NO_BLOCK_SKIP mode is all-or-nothing: 0 means whole packet lost */
+    if (written > 0) {
+        s_bytes_written += written;
+    } else {
+        s_packets_dropped++;
+    }
     taskEXIT_CRITICAL();
 
     return written;
+#endif
+}
+
+void telemetry_flush(void) {
+#if TELEMETRY_BATCHING
+    if (!s_telemetry_initialized) return;
+    taskENTER_CRITICAL();
+    _flush_locked();
+    taskEXIT_CRITICAL();
+#endif
+}
+
+uint32_t telemetry_bytes_written(void) {
+    return s_bytes_written;
+}
+
+uint32_t telemetry_packets_dropped(void) {
+    return s_packets_dropped;
 }
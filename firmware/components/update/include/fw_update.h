@@ -0,0 +1,193 @@
+/**
+ * @file fw_update.h
+ * @brief BB6: A/B firmware image staging — public API.
+ *
+ * Accepts a new firmware image in chunks (from any transport — RTT
+ * down-channel, UART, test harness), stages it into a dedicated raw
+ * flash slot, CRC-verifies it, and applies it at the next boot with a
+ * RAM-resident copy routine. A control sector between the staging slot
+ * and the asset store tracks the update state machine across reboots.
+ *
+ * Flash layout (see fs_config.h for the full map):
+ *
+ *   Slot A (active) : 0x000000 - 0x0FCFFF  executing image (XIP)
+ *   Slot B (staging): 0x0FD000 - 0x1D8FFF  880KB staged image
+ *   Log persist ring: 0x1D9000 - 0x1DCFFF  16KB tokenized log history
+ *   Control sector  : 0x1DD000 - 0x1DDFFF  update state machine
+ *
+ * Bounded jitter: staging runs in a dedicated idle-tier task that
+ * performs ONE flash operation per wakeup — a single page program
+ * (~few hundred µs of dual-core lockout) or a single sector erase
+ * (the long pole, ~tens of ms, spaced FW_UPDATE_OP_SPACING_MS apart so
+ * the lockout duty cycle stays low). Erases run ahead of programs, so
+ * steady-state staging is page-programs only. Chunk ingest itself
+ * never touches flash — it lands in a RAM ring.
+ *
+ * State machine (control sector):
+ *
+ *   IDLE → (finish, CRC ok) → STAGED → (apply) → PENDING
+ *   PENDING → boot check verifies CRC → TESTING → RAM copy → reset
+ *   TESTING → fw_update_confirm() after a healthy run → CONFIRMED
+ *   TESTING + FW_UPDATE_MAX_BOOT_ATTEMPTS watchdog resets → FAILED
+ *
+ * ⚠️ Honest limits (no boot-stage shim in this tree):
+ *   - The RAM copy overwrites slot A in place. Power loss during the
+ *     copy window (~1-2s) bricks the device — the staged image
+ *     survives in slot B, but nothing below the application exists to
+ *     re-apply it. True power-fail-safe A/B needs a boot shim that
+ *     selects a slot before XIP; the control-sector format is designed
+ *     so one can adopt it later.
+ *   - FAILED stops further boot attempts of the state machine but
+ *     cannot restore the previous image (it was overwritten). The
+ *     watchdog crash ring captures the failing boots for post-mortem.
+ *
+ * Thread Safety:
+ *   - fw_update_write() is single-producer: one transport task feeds
+ *     the ring. begin/finish/apply from that same task.
+ *   - fw_update_boot_check() MUST run before the scheduler starts.
+ */
+
+#ifndef FW_UPDATE_H
+#define FW_UPDATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Slot Layout — anchored to the persistence flash map
+ * ========================================================================= */
+
+/** Staging slot capacity. The incoming image must fit here AND in the
+ *  active region below the slot (slot A is 1012KB — staging size is
+ *  the binding limit). Shrank from 896KB when the log persistence ring
+ *  (FS_LOG_RING_SIZE) was carved from the top of the slot. */
+#define FW_UPDATE_SLOT_SIZE         (880 * 1024)
+
+/** Control sector offset — one sector directly below the asset store
+ *  (FS_ASSET_REGION_OFFSET - FLASH_SECTOR_SIZE). Kept as a literal so
+ *  this header does not drag in fs_config.h/hardware_flash. */
+#define FW_UPDATE_CTRL_OFFSET       0x1DD000u
+
+/** Staging slot offset (slot B) — directly after slot A. The slot now
+ *  ends at the log persistence ring (0x1D9000), not the control sector. */
+#define FW_UPDATE_STAGING_OFFSET    0x0FD000u
+
+/* =========================================================================
+ * Staging Task Configuration
+ * ========================================================================= */
+
+/** RAM ring between fw_update_write() and the staging task. Must be a
+ *  power of two. 4KB absorbs a full sector of in-flight chunks. */
+#define FW_UPDATE_RING_SIZE         4096
+
+/** Minimum spacing between consecutive flash operations while staging.
+ *  Bounds the dual-core lockout duty cycle: with 5ms spacing and
+ *  ~500µs page programs, staging steals <10% and adds at most one
+ *  page-program stall to any task's window. */
+#define FW_UPDATE_OP_SPACING_MS     5
+
+/** Staging task priority — idle tier, same as the committer/flusher.
+ *  Flash stalls come from the lockout, not from preemption, so there
+ *  is no reason to run higher. */
+#define FW_UPDATE_STAGER_PRIORITY   (tskIDLE_PRIORITY + 1)
+
+/** Staging task stack size (words). */
+#define FW_UPDATE_STAGER_STACK_SIZE (configMINIMAL_STACK_SIZE * 2)
+
+/** Watchdog-reset boots in TESTING before the update is declared
+ *  FAILED and the state machine stops retrying. */
+#define FW_UPDATE_MAX_BOOT_ATTEMPTS 3
+
+/* =========================================================================
+ * Update State (control sector)
+ * ========================================================================= */
+
+typedef enum {
+    FW_UPDATE_STATE_IDLE      = 0,           /**< No update in flight */
+    FW_UPDATE_STATE_STAGED    = 0x53544147u, /**< "STAG" — verified in slot B */
+    FW_UPDATE_STATE_PENDING   = 0x50454E44u, /**< "PEND" — apply at next boot */
+    FW_UPDATE_STATE_TESTING   = 0x54455354u, /**< "TEST" — new image, unconfirmed */
+    FW_UPDATE_STATE_CONFIRMED = 0x434F4E46u, /**< "CONF" — new image healthy */
+    FW_UPDATE_STATE_FAILED    = 0x4641494Cu, /**< "FAIL" — gave up */
+} fw_update_state_t;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Start a staging session.
+ *
+ * Records the expected image size and CRC32, creates the staging task
+ * if it is not running yet, and resets the erase/program frontiers.
+ * Fails if a session is already open or the image exceeds the slot.
+ *
+ * @param image_size  Total image size in bytes
+ * @param image_crc   CRC32 (IEEE, reflected) of the full image
+ * @return true if the session is open and fw_update_write() may be fed
+ */
+bool fw_update_begin(uint32_t image_size, uint32_t image_crc);
+
+/**
+ * @brief Feed image bytes into the staging ring.
+ *
+ * Non-blocking: returns the number of bytes accepted (0 when the ring
+ * is full — back off and retry; the staging task drains at flash
+ * speed). Single producer only.
+ */
+uint32_t fw_update_write(const void *data, uint32_t length);
+
+/**
+ * @brief Bytes programmed into the staging slot so far.
+ *
+ * For transport-side progress/flow control.
+ */
+uint32_t fw_update_bytes_staged(void);
+
+/**
+ * @brief Close the session: drain, pad, and verify the staged image.
+ *
+ * Blocks until the staging task has programmed every byte, then CRCs
+ * the staged image in XIP against the value from fw_update_begin().
+ * On match the control sector advances to STAGED.
+ *
+ * @return true if the slot now holds a verified image
+ */
+bool fw_update_finish(void);
+
+/**
+ * @brief Schedule the staged image for the next boot and reboot.
+ *
+ * Advances STAGED → PENDING and triggers a watchdog reboot. Only
+ * returns on failure (nothing staged / control write failed).
+ */
+bool fw_update_apply(void);
+
+/**
+ * @brief Boot-time slot selector — call from main() BEFORE the scheduler.
+ *
+ * PENDING: re-verifies the staged CRC, advances to TESTING, copies
+ * slot B over slot A from a RAM-resident routine (IRQs off, single
+ * core) and resets — does not return on that path. TESTING: counts
+ * the boot attempt; past FW_UPDATE_MAX_BOOT_ATTEMPTS watchdog resets
+ * the state goes FAILED. Everything else: near-free (one XIP read).
+ */
+void fw_update_boot_check(void);
+
+/**
+ * @brief Mark the running (TESTING) image as healthy.
+ *
+ * Call after the system demonstrably works — e.g. from the supervisor
+ * once a full telemetry cycle completes with the watchdog fed. Until
+ * confirmed, every watchdog reset burns a boot attempt.
+ *
+ * @return true if the state advanced to CONFIRMED (or already was)
+ */
+bool fw_update_confirm(void);
+
+/**
+ * @brief Current update state from the control sector.
+ */
+fw_update_state_t fw_update_get_state(void);
+
+#endif /* FW_UPDATE_H */
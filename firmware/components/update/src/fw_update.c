@@ -0,0 +1,498 @@
+/**
+ * @file fw_update.c
+ * @brief BB6: A/B firmware image staging — slot B writer + boot selector.
+ *
+ * Three pieces:
+ *
+ *   1. Ingest: fw_update_write() copies chunks into a RAM ring —
+ *      never touches flash, so the transport task sees no stalls.
+ *   2. Staging task: drains the ring into slot B, ONE flash operation
+ *      per wakeup (page program or sector erase), spaced
+ *      FW_UPDATE_OP_SPACING_MS apart to bound the dual-core lockout
+ *      duty cycle. Erases run one sector ahead of the program
+ *      frontier, so the steady state is page programs only.
+ *   3. Boot selector: fw_update_boot_check() runs before the scheduler
+ *      (single core, no tasks) and applies a PENDING image with a
+ *      RAM-resident copy loop — nothing executes from flash while
+ *      slot A is being rewritten.
+ *
+ * Control-sector writes go through flash_safe_op() like every other
+ * flash mutation in the tree (works pre-scheduler too, same as the
+ * crash reporter's boot-path writes).
+ */
+
+#include "fw_update.h"
+#include "fs_config.h"
+#include "flash_safe.h"
+#include "watchdog_hal.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>  /* offsetof */
+
+/* Keep the header's literals anchored to the persistence flash map */
+#if FW_UPDATE_CTRL_OFFSET != (FS_ASSET_REGION_OFFSET - FLASH_SECTOR_SIZE)
+#error "FW_UPDATE_CTRL_OFFSET out of sync with fs_config.h flash map"
+#endif
+#if (FW_UPDATE_STAGING_OFFSET + FW_UPDATE_SLOT_SIZE) != FS_LOG_RING_OFFSET
+#error "Slot B must end exactly at the log persistence ring"
+#endif
+
+/* =========================================================================
+ * XIP Access
+ * ========================================================================= */
+
+/** XIP (Execute-In-Place) base address for memory-mapped flash access. */
+#define XIP_BASE_ADDR   0x10000000u
+
+#define STAGING_XIP     ((const uint8_t *)(XIP_BASE_ADDR + FW_UPDATE_STAGING_OFFSET))
+#define CTRL_XIP        ((const uint8_t *)(XIP_BASE_ADDR + FW_UPDATE_CTRL_OFFSET))
+
+/* =========================================================================
+ * Control Sector Layout
+ * ========================================================================= */
+
+/** Magic marking a valid control block ("FWUP"). */
+#define CTRL_MAGIC      0x46575550u
+
+/** Control format version. */
+#define CTRL_VERSION    1u
+
+/**
+ * @brief Update state machine record, one per control sector.
+ *
+ * CRC32 covers everything before the crc32 field. Rewritten (erase +
+ * one-page program) on every state transition — a handful of cycles
+ * per update, negligible wear.
+ */
+typedef struct {
+    uint32_t magic;          /**< CTRL_MAGIC */
+    uint32_t version;        /**< CTRL_VERSION */
+    uint32_t state;          /**< fw_update_state_t */
+    uint32_t image_size;     /**< Staged image size in bytes */
+    uint32_t image_crc;      /**< Expected CRC32 of the image */
+    uint32_t boot_attempts;  /**< Boots consumed in TESTING */
+    uint32_t crc32;          /**< CRC32 of all preceding bytes */
+} __attribute__((packed)) fw_ctrl_t;
+
+/* =========================================================================
+ * Module State
+ * ========================================================================= */
+
+/** Staging ring — RAM buffer between transport and staging task. */
+static uint8_t s_ring[FW_UPDATE_RING_SIZE];
+static volatile uint32_t s_ring_head;   /* Producer-owned */
+static volatile uint32_t s_ring_tail;   /* Consumer-owned */
+
+/** Open session parameters (valid while s_session_open). */
+static uint32_t s_image_size;
+static uint32_t s_image_crc;
+static volatile bool s_session_open = false;
+static volatile bool s_finalize = false;
+
+/** Program frontier: bytes committed to slot B flash. */
+static volatile uint32_t s_prog_bytes;
+/** Erase frontier: bytes of slot B erased (sector multiple). */
+static uint32_t s_erased_bytes;
+
+/** Partial-page accumulator (staging task only). */
+static uint8_t s_page_buf[FLASH_PAGE_SIZE];
+static uint32_t s_page_fill;
+
+/** Staging task (created lazily by the first fw_update_begin()). */
+static TaskHandle_t s_stager_handle = NULL;
+
+/* =========================================================================
+ * CRC32 (IEEE 802.3, reflected, poly 0xEDB88320)
+ *
+ * Bitwise, table-free. Runs over the full image exactly twice per
+ * update (finish + boot re-verify) — ~1s worst case for a full slot,
+ * paid only on update boots.
+ * ========================================================================= */
+
+static uint32_t _crc32(const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (unsigned bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/* =========================================================================
+ * Control Sector Read/Write
+ * ========================================================================= */
+
+static bool _ctrl_read(fw_ctrl_t *out) {
+    memcpy(out, CTRL_XIP, sizeof(*out));
+    if (out->magic != CTRL_MAGIC || out->version != CTRL_VERSION) {
+        return false;
+    }
+    return _crc32(out, offsetof(fw_ctrl_t, crc32)) == out->crc32;
+}
+
+typedef struct {
+    const uint8_t *page;
+} ctrl_write_params_t;
+
+static void _ctrl_write_callback(void *param) {
+    ctrl_write_params_t *p = (ctrl_write_params_t *)param;
+    flash_range_erase(FW_UPDATE_CTRL_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(FW_UPDATE_CTRL_OFFSET, p->page, FLASH_PAGE_SIZE);
+}
+
+static bool _ctrl_write(uint32_t state, uint32_t image_size,
+                        uint32_t image_crc, uint32_t boot_attempts) {
+    static uint8_t page[FLASH_PAGE_SIZE];   /* Program wants page granularity */
+    memset(page, 0xFF, sizeof(page));
+
+    fw_ctrl_t ctrl = {
+        .magic         = CTRL_MAGIC,
+        .version       = CTRL_VERSION,
+        .state         = state,
+        .image_size    = image_size,
+        .image_crc     = image_crc,
+        .boot_attempts = boot_attempts,
+    };
+    ctrl.crc32 = _crc32(&ctrl, offsetof(fw_ctrl_t, crc32));
+    memcpy(page, &ctrl, sizeof(ctrl));
+
+    ctrl_write_params_t params = { .page = page };
+    if (!flash_safe_op(_ctrl_write_callback, &params)) {
+        printf("[fw_update] Control sector write failed\n");
+        return false;
+    }
+    return true;
+}
+
+/* =========================================================================
+ * Staging Flash Operations (flash_safe_op callbacks)
+ * ========================================================================= */
+
+typedef struct {
+    uint32_t flash_offset;
+    const uint8_t *data;
+} page_prog_params_t;
+
+static void _page_prog_callback(void *param) {
+    page_prog_params_t *p = (page_prog_params_t *)param;
+    flash_range_program(p->flash_offset, p->data, FLASH_PAGE_SIZE);
+}
+
+static void _sector_erase_callback(void *param) {
+    uint32_t *offset = (uint32_t *)param;
+    flash_range_erase(*offset, FLASH_SECTOR_SIZE);
+}
+
+/* =========================================================================
+ * Staging Task
+ * ========================================================================= */
+
+static inline uint32_t _ring_available(void) {
+    return s_ring_head - s_ring_tail;
+}
+
+/**
+ * @brief Perform at most ONE flash operation; returns true if it did.
+ *
+ * Priority: erase ahead of the program frontier first, then program a
+ * full page (or the padded final partial page when finalizing).
+ */
+static bool _stage_one_op(void) {
+    /* Keep one erased sector of headroom ahead of the program frontier */
+    if (s_prog_bytes + FLASH_PAGE_SIZE > s_erased_bytes &&
+        s_erased_bytes < FW_UPDATE_SLOT_SIZE) {
+        uint32_t offset = FW_UPDATE_STAGING_OFFSET + s_erased_bytes;
+        if (!flash_safe_op(_sector_erase_callback, &offset)) {
+            return false;
+        }
+        s_erased_bytes += FLASH_SECTOR_SIZE;
+        return true;
+    }
+
+    /* Top up the page accumulator from the ring */
+    while (s_page_fill < FLASH_PAGE_SIZE && _ring_available() > 0) {
+        s_page_buf[s_page_fill++] = s_ring[s_ring_tail & (FW_UPDATE_RING_SIZE - 1)];
+        s_ring_tail++;
+    }
+
+    bool flush_partial = s_finalize && _ring_available() == 0 && s_page_fill > 0;
+    if (s_page_fill == FLASH_PAGE_SIZE || flush_partial) {
+        if (flush_partial) {
+            memset(&s_page_buf[s_page_fill], 0xFF,
+                   FLASH_PAGE_SIZE - s_page_fill);
+        }
+        page_prog_params_t params = {
+            .flash_offset = FW_UPDATE_STAGING_OFFSET + s_prog_bytes,
+            .data = s_page_buf,
+        };
+        if (!flash_safe_op(_page_prog_callback, &params)) {
+            return false;
+        }
+        s_prog_bytes += s_page_fill;
+        s_page_fill = 0;
+        return true;
+    }
+
+    return false;   /* Nothing to do — wait for more chunks */
+}
+
+/**
+ * @brief Staging task — one bounded flash stall per wakeup.
+ *
+ * Sleeps on its notification when the ring is empty; while work is
+ * queued it paces itself with FW_UPDATE_OP_SPACING_MS between
+ * operations so the rest of the system keeps its scheduling jitter.
+ */
+static void _fw_stager_task(void *params) {
+    (void)params;
+
+    for (;;) {
+        if (_stage_one_op()) {
+            vTaskDelay(pdMS_TO_TICKS(FW_UPDATE_OP_SPACING_MS));
+        } else {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+}
+
+/* =========================================================================
+ * Public API — staging session
+ * ========================================================================= */
+
+bool fw_update_begin(uint32_t image_size, uint32_t image_crc) {
+    if (s_session_open) {
+        printf("[fw_update] Session already open\n");
+        return false;
+    }
+    if (image_size == 0 || image_size > FW_UPDATE_SLOT_SIZE) {
+        printf("[fw_update] Image size %lu exceeds %u-byte slot\n",
+               (unsigned long)image_size, (unsigned)FW_UPDATE_SLOT_SIZE);
+        return false;
+    }
+
+    if (s_stager_handle == NULL) {
+        BaseType_t ret = xTaskCreate(
+            _fw_stager_task,
+            "fw_stager",
+            FW_UPDATE_STAGER_STACK_SIZE,
+            NULL,
+            FW_UPDATE_STAGER_PRIORITY,
+            &s_stager_handle
+        );
+        if (ret != pdPASS) {
+            printf("[fw_update] Failed to create staging task\n");
+            s_stager_handle = NULL;
+            return false;
+        }
+    }
+
+    s_image_size = image_size;
+    s_image_crc = image_crc;
+    s_ring_head = s_ring_tail = 0;
+    s_prog_bytes = 0;
+    s_erased_bytes = 0;
+    s_page_fill = 0;
+    s_finalize = false;
+    s_session_open = true;
+
+    printf("[fw_update] Staging session open: %lu bytes, CRC 0x%08lx\n",
+           (unsigned long)image_size, (unsigned long)image_crc);
+    return true;
+}
+
+uint32_t fw_update_write(const void *data, uint32_t length) {
+    if (!s_session_open || s_finalize) return 0;
+
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t space = FW_UPDATE_RING_SIZE - _ring_available();
+    uint32_t n = (length < space) ? length : space;
+
+    for (uint32_t i = 0; i < n; i++) {
+        s_ring[s_ring_head & (FW_UPDATE_RING_SIZE - 1)] = bytes[i];
+        s_ring_head++;
+    }
+
+    if (n > 0 && s_stager_handle != NULL) {
+        xTaskNotifyGive(s_stager_handle);
+    }
+    return n;
+}
+
+uint32_t fw_update_bytes_staged(void) {
+    return s_prog_bytes;
+}
+
+bool fw_update_finish(void) {
+    if (!s_session_open) return false;
+
+    s_finalize = true;
+    xTaskNotifyGive(s_stager_handle);
+
+    /* Drain: generous cap — a full slot is ~220 sector erases and
+     * ~3600 page programs at the configured spacing (< 30s). */
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(60000);
+    while (s_prog_bytes < s_image_size) {
+        if (xTaskGetTickCount() > deadline) {
+            printf("[fw_update] Staging stalled: %lu/%lu bytes\n",
+                   (unsigned long)s_prog_bytes, (unsigned long)s_image_size);
+            s_session_open = false;
+            return false;
+        }
+        xTaskNotifyGive(s_stager_handle);
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+
+    uint32_t crc = _crc32(STAGING_XIP, s_image_size);
+    s_session_open = false;
+
+    if (crc != s_image_crc) {
+        printf("[fw_update] Staged CRC mismatch: 0x%08lx != 0x%08lx\n",
+               (unsigned long)crc, (unsigned long)s_image_crc);
+        return false;
+    }
+
+    if (!_ctrl_write(FW_UPDATE_STATE_STAGED, s_image_size, s_image_crc, 0)) {
+        return false;
+    }
+
+    printf("[fw_update] Image staged and verified (%lu bytes)\n",
+           (unsigned long)s_image_size);
+    return true;
+}
+
+bool fw_update_apply(void) {
+    fw_ctrl_t ctrl;
+    if (!_ctrl_read(&ctrl) || ctrl.state != FW_UPDATE_STATE_STAGED) {
+        printf("[fw_update] No staged image to apply\n");
+        return false;
+    }
+
+    if (!_ctrl_write(FW_UPDATE_STATE_PENDING, ctrl.image_size,
+                     ctrl.image_crc, 0)) {
+        return false;
+    }
+
+    printf("[fw_update] Rebooting to apply staged image...\n");
+    watchdog_reboot(0, 0, 10);
+    for (;;) { tight_loop_contents(); }
+}
+
+/* =========================================================================
+ * Boot-Time Slot Selector
+ * ========================================================================= */
+
+/**
+ * @brief Copy slot B over slot A and reset. RAM-resident — MUST NOT
+ *        touch anything that executes from flash.
+ *
+ * Runs pre-scheduler on core 0 with IRQs off; core 1 has not been
+ * started. Page-granular copy: read a staged page through XIP (valid
+ * between flash calls), erase the destination sector when crossing a
+ * sector boundary, program. The SDK's flash_range_* are themselves
+ * RAM-resident. Ends with a raw AIRCR SYSRESETREQ — watchdog_reboot()
+ * lives in the flash we just rewrote.
+ */
+static void __not_in_flash_func(_apply_from_ram)(uint32_t image_size) {
+    static uint8_t page[FLASH_PAGE_SIZE];
+
+    (void)save_and_disable_interrupts();
+
+    uint32_t total = (image_size + FLASH_PAGE_SIZE - 1) & ~(FLASH_PAGE_SIZE - 1u);
+    for (uint32_t off = 0; off < total; off += FLASH_PAGE_SIZE) {
+        const uint8_t *src = STAGING_XIP + off;
+        for (uint32_t i = 0; i < FLASH_PAGE_SIZE; i++) {
+            page[i] = src[i];
+        }
+        if ((off & (FLASH_SECTOR_SIZE - 1)) == 0) {
+            flash_range_erase(off, FLASH_SECTOR_SIZE);
+        }
+        flash_range_program(off, page, FLASH_PAGE_SIZE);
+    }
+
+    /* SCB->AIRCR: VECTKEY | SYSRESETREQ */
+    *(volatile uint32_t *)0xE000ED0Cu = 0x05FA0004u;
+    for (;;) { __asm volatile ("nop"); }
+}
+
+void fw_update_boot_check(void) {
+    fw_ctrl_t ctrl;
+    if (!_ctrl_read(&ctrl)) {
+        return;     /* Erased/invalid control sector — no update in flight */
+    }
+
+    switch (ctrl.state) {
+    case FW_UPDATE_STATE_PENDING: {
+        uint32_t crc = _crc32(STAGING_XIP, ctrl.image_size);
+        if (crc != ctrl.image_crc) {
+            printf("[fw_update] PENDING image CRC bad, aborting update\n");
+            _ctrl_write(FW_UPDATE_STATE_FAILED, ctrl.image_size,
+                        ctrl.image_crc, 0);
+            return;
+        }
+        /* TESTING is written BEFORE the copy: a power cut inside the
+         * copy window must not retrigger an apply over a half-written
+         * slot A on the (unlikely) next boot. */
+        _ctrl_write(FW_UPDATE_STATE_TESTING, ctrl.image_size,
+                    ctrl.image_crc, 1);
+        printf("[fw_update] Applying staged image (%lu bytes)...\n",
+               (unsigned long)ctrl.image_size);
+        _apply_from_ram(ctrl.image_size);
+        /* Not reached */
+        break;
+    }
+
+    case FW_UPDATE_STATE_TESTING:
+        if (!watchdog_hal_caused_reboot()) {
+            printf("[fw_update] New image booting (attempt %lu), awaiting confirm\n",
+                   (unsigned long)ctrl.boot_attempts);
+            break;      /* Clean boot — don't burn an attempt */
+        }
+        if (ctrl.boot_attempts >= FW_UPDATE_MAX_BOOT_ATTEMPTS) {
+            printf("[fw_update] New image failed %lu boots — giving up "
+                   "(no boot shim, cannot restore old image)\n",
+                   (unsigned long)ctrl.boot_attempts);
+            _ctrl_write(FW_UPDATE_STATE_FAILED, ctrl.image_size,
+                        ctrl.image_crc, ctrl.boot_attempts);
+            break;
+        }
+        _ctrl_write(FW_UPDATE_STATE_TESTING, ctrl.image_size,
+                    ctrl.image_crc, ctrl.boot_attempts + 1);
+        printf("[fw_update] Watchdog reset in TESTING — attempt %lu/%u\n",
+               (unsigned long)(ctrl.boot_attempts + 1),
+               (unsigned)FW_UPDATE_MAX_BOOT_ATTEMPTS);
+        break;
+
+    default:
+        break;          /* IDLE / STAGED / CONFIRMED / FAILED — nothing */
+    }
+}
+
+bool fw_update_confirm(void) {
+    fw_ctrl_t ctrl;
+    if (!_ctrl_read(&ctrl)) return false;
+
+    if (ctrl.state == FW_UPDATE_STATE_CONFIRMED) return true;
+    if (ctrl.state != FW_UPDATE_STATE_TESTING) return false;
+
+    if (!_ctrl_write(FW_UPDATE_STATE_CONFIRMED, ctrl.image_size,
+                     ctrl.image_crc, ctrl.boot_attempts)) {
+        return false;
+    }
+    printf("[fw_update] Update confirmed healthy\n");
+    return true;
+}
+
+fw_update_state_t fw_update_get_state(void) {
+    fw_ctrl_t ctrl;
+    if (!_ctrl_read(&ctrl)) return FW_UPDATE_STATE_IDLE;
+    return (fw_update_state_t)ctrl.state;
+}
@@ -67,9 +67,9 @@
 /* =========================================================================
  * 4. Hook Functions
  * ========================================================================= */
-#define configUSE_IDLE_HOOK                          0
+#define configUSE_IDLE_HOOK                          1   /* WFI doze (power_profile.c) */
 #define configUSE_TICK_HOOK                          0
-#define configUSE_PASSIVE_IDLE_HOOK                  0   /* V11.2.0 SMP: passive idle hook (not needed yet) */
+#define configUSE_PASSIVE_IDLE_HOOK                  1   /* V11.2.0 SMP: second core dozes too */
 #define configUSE_MALLOC_FAILED_HOOK                 1   /* Critical for AI debugging */
 #define configCHECK_FOR_STACK_OVERFLOW               2   /* Method 2: pattern-based (BB5 requirement) */
 
@@ -88,6 +88,38 @@
 #define configRECORD_STACK_HIGH_ADDRESS              0   /* Disabled in production */
 #endif
 
+/* Context-switch trace hooks — every switch-in/out is streamed to RTT
+ * Channel 3 by the instrumentation component (task_trace.c). The hook
+ * is a few dozen cycles (timer read + 2-6 ring bytes, no locks) and is
+ * compiled out in production. Override per-build with
+ * -DAI_TASK_TRACE_ENABLED=0 if a soak test must exclude even that. */
+#ifndef BUILD_PRODUCTION
+#ifndef AI_TASK_TRACE_ENABLED
+#define AI_TASK_TRACE_ENABLED                        1
+#endif
+#if AI_TASK_TRACE_ENABLED && !defined(__ASSEMBLER__)
+extern void _task_trace_switch(unsigned dir_in, unsigned task_number);
+/* Wrap-free 64-bit runtime + scheduling-latency accounting
+ * (instrumentation component, sched_stats.c). Keyed by the kernel's
+ * never-reused uxTCBNumber — the settable uxTaskNumber above is only
+ * the 7-bit trace-stream ID. */
+extern void _sched_stats_switch(unsigned dir_in, unsigned task_number);
+extern void _sched_stats_ready(unsigned task_number);
+#define traceTASK_SWITCHED_IN() \
+    do { \
+        _task_trace_switch(1u, (unsigned)pxCurrentTCB->uxTaskNumber); \
+        _sched_stats_switch(1u, (unsigned)pxCurrentTCB->uxTCBNumber); \
+    } while (0)
+#define traceTASK_SWITCHED_OUT() \
+    do { \
+        _task_trace_switch(0u, (unsigned)pxCurrentTCB->uxTaskNumber); \
+        _sched_stats_switch(0u, (unsigned)pxCurrentTCB->uxTCBNumber); \
+    } while (0)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    _sched_stats_ready((unsigned)(pxTCB)->uxTCBNumber)
+#endif
+#endif
+
 /* Runtime stats timer — RP2040's 1MHz timer is initialized by SDK, no-op here.
  * Cannot use time_us_32() directly here due to circular include dependency:
  * FreeRTOSConfig.h is included before pico/time.h through freertos_sdk_config.h.
@@ -0,0 +1,41 @@
+/**
+ * @file ai_hot.h
+ * @brief AI_HOT_FUNC — SRAM placement for latency-critical functions.
+ *
+ * Everything executes from XIP flash by default, so a hot path's cost
+ * is bimodal: cached it runs at SRAM speed, after a cache miss it
+ * stalls for the QSPI fetch — worst right after flash_safe_op() has
+ * thrashed the XIP cache with LittleFS traffic. Marking a function
+ * with AI_HOT_FUNC pins it in SRAM so its worst case equals its best
+ * case.
+ *
+ * Usage (wraps the function NAME at the definition):
+ *
+ *   unsigned AI_HOT_FUNC(log_varint_encode_u32)(uint32_t v, uint8_t *b) {
+ *
+ * Mechanism: expands to the Pico SDK's __not_in_flash_func(), which
+ * places the function in a named .time_critical.* section. The SDK's
+ * default linker script links those sections into RAM and crt0 copies
+ * them from flash before main() — no custom linker fragment and no
+ * copy step in system_init() needed, and the function is RAM-resident
+ * even for pre-scheduler callers. On host builds (unit tests, bench)
+ * the annotation disappears.
+ *
+ * Budget: every marked function permanently costs its code size in
+ * SRAM. Run tools/build_helpers/ram_func_report.py against the build's
+ * .map file for the per-function and total spend; keep the set to
+ * paths with measured bimodal latency (bench: flash_lockout/erase4k
+ * vs log_write numbers).
+ */
+
+#ifndef AI_HOT_H
+#define AI_HOT_H
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "pico/platform.h"
+#define AI_HOT_FUNC(func)   __not_in_flash_func(func)
+#else
+#define AI_HOT_FUNC(func)   func    /* Host builds: normal placement */
+#endif
+
+#endif /* AI_HOT_H */
@@ -0,0 +1,100 @@
+/**
+ * @file core_mailbox.c
+ * @brief Lock-free inter-core mailbox — see core_mailbox.h.
+ *
+ * One SPSC ring per direction with free-running 32-bit indices (the
+ * same head/tail pattern as the task_trace and fw_update rings):
+ * head - tail is the fill level, indices wrap naturally, and each
+ * index has exactly one writer, so no lock and no read-modify-write
+ * race exists by construction.
+ */
+
+#include "core_mailbox.h"
+#include "pico/platform.h"      /* get_core_num() */
+#include <string.h>
+#include <stdio.h>
+
+#if (CORE_MAILBOX_DEPTH & (CORE_MAILBOX_DEPTH - 1)) != 0
+#error "CORE_MAILBOX_DEPTH must be a power of two"
+#endif
+
+#define SLOT_MASK   (CORE_MAILBOX_DEPTH - 1)
+
+/* =========================================================================
+ * Per-Direction Ring State — index 0 drains on Core 0, 1 on Core 1
+ * ========================================================================= */
+
+typedef struct {
+    core_mailbox_msg_t slots[CORE_MAILBOX_DEPTH];
+    volatile uint32_t head;     /* Write index — sender only */
+    volatile uint32_t tail;     /* Read index — receiver only */
+    volatile uint32_t dropped;  /* try_send rejections (ring full) */
+    TaskHandle_t wakeup;        /* Notified on arrival, NULL = none */
+} mailbox_ring_t;
+
+static mailbox_ring_t s_rings[2];
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+void core_mailbox_init(void) {
+    memset(s_rings, 0, sizeof(s_rings));
+    printf("[core_mailbox] Init complete, depth=%d msgs/direction\n",
+           CORE_MAILBOX_DEPTH);
+}
+
+bool core_mailbox_try_send(unsigned dest_core, const core_mailbox_msg_t *msg) {
+    if (dest_core >= 2) return false;
+    mailbox_ring_t *ring = &s_rings[dest_core];
+
+    uint32_t head = ring->head;
+    if (head - ring->tail >= CORE_MAILBOX_DEPTH) {
+        ring->dropped++;        /* Receiver stalled — shed, don't block */
+        return false;
+    }
+
+    ring->slots[head & SLOT_MASK] = *msg;
+
+    /* Publish after the slot write — compiler barrier; M0+ is in-order */
+    __asm volatile("" ::: "memory");
+    ring->head = head + 1;
+
+    if (ring->wakeup != NULL) {
+        if (portCHECK_IF_IN_ISR()) {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveFromISR(ring->wakeup, &woken);
+            portYIELD_FROM_ISR(woken);
+        } else {
+            xTaskNotifyGive(ring->wakeup);
+        }
+    }
+    return true;
+}
+
+bool core_mailbox_try_recv(core_mailbox_msg_t *msg) {
+    mailbox_ring_t *ring = &s_rings[get_core_num()];
+
+    uint32_t tail = ring->tail;
+    if (tail == ring->head) return false;
+
+    *msg = ring->slots[tail & SLOT_MASK];
+
+    /* Release the slot only after the copy is done */
+    __asm volatile("" ::: "memory");
+    ring->tail = tail + 1;
+    return true;
+}
+
+void core_mailbox_set_wakeup(unsigned core, TaskHandle_t task) {
+    if (core < 2) s_rings[core].wakeup = task;
+}
+
+uint32_t core_mailbox_dropped(unsigned dest_core) {
+    return (dest_core < 2) ? s_rings[dest_core].dropped : 0;
+}
+
+unsigned core_mailbox_pending(unsigned dest_core) {
+    if (dest_core >= 2) return 0;
+    return s_rings[dest_core].head - s_rings[dest_core].tail;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file core_mailbox.h
+ * @brief Lock-free inter-core mailbox — fixed 8-byte messages, SPSC.
+ *
+ * FreeRTOS queues are SMP-safe through critical sections backed by
+ * hardware spin locks, so a high-rate producer/consumer pair split
+ * across cores makes both cores contend on the same lock for every
+ * message. The mailbox replaces that with one single-producer/
+ * single-consumer ring per direction: the sender owns the write index,
+ * the receiver owns the read index, and neither takes any lock.
+ *
+ * The request-obvious transport — the RP2040 SIO inter-core FIFO and
+ * its IRQ — is owned by the FreeRTOS SMP port, which uses it for
+ * cross-core scheduler IPC; claiming it here would break the kernel.
+ * On the RP2040 both cores see all of SRAM at single-cycle latency,
+ * so plain SRAM rings cost the same per word as the FIFO without the
+ * 8-entry depth limit, and the "doorbell" is an optional cross-core
+ * task notification instead of the FIFO IRQ.
+ *
+ * Ordering: the Cortex-M0+ is in-order and non-speculative, so a
+ * compiler barrier before the index publish is sufficient (same
+ * reasoning as the task_trace rings).
+ *
+ * Constraints:
+ *   - One producer and one consumer per direction. Two tasks on the
+ *     SAME core may also use it (SPSC still holds), but cross-core
+ *     decoupling is the point.
+ *   - try_send from task or ISR context; the notification wakeup is
+ *     sent with the FromISR variant when called inside an ISR.
+ */
+
+#ifndef CORE_MAILBOX_H
+#define CORE_MAILBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* =========================================================================
+ * Configuration
+ * ========================================================================= */
+
+/** Messages per direction. Must be a power of two. 32 × 8B = 256B of
+ *  SRAM per direction — headroom for a 500ms consumer stall at the
+ *  supervisor's cadence without drops. */
+#define CORE_MAILBOX_DEPTH      32
+
+/* =========================================================================
+ * Message Type
+ * ========================================================================= */
+
+/**
+ * @brief Fixed 8-byte mailbox message — one command word + one argument.
+ *
+ * Copied whole into the ring; the pointer is not retained, so stack
+ * messages are fine.
+ */
+typedef struct {
+    uint32_t cmd;           /**< Application-defined command/opcode */
+    uint32_t arg;           /**< Payload word (or pointer cast) */
+} core_mailbox_msg_t;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Reset both direction rings and clear wakeup registrations.
+ *
+ * ⚠️ Call from main() before the scheduler starts (before any sender
+ * can run on either core).
+ */
+void core_mailbox_init(void);
+
+/**
+ * @brief Non-blocking send to the mailbox draining on dest_core.
+ *
+ * Copies the message into the ring and, if the receiver registered a
+ * wakeup task, gives it a task notification. Never blocks; a full
+ * ring rejects the message and bumps the drop counter.
+ *
+ * @param dest_core  Core whose receiver should see the message (0 or 1)
+ * @param msg        Message to copy (8 bytes)
+ * @return true if queued, false if the ring was full
+ */
+bool core_mailbox_try_send(unsigned dest_core, const core_mailbox_msg_t *msg);
+
+/**
+ * @brief Non-blocking receive from the calling core's mailbox.
+ *
+ * @param msg  Filled with the oldest pending message on success
+ * @return true if a message was dequeued, false if the ring was empty
+ */
+bool core_mailbox_try_recv(core_mailbox_msg_t *msg);
+
+/**
+ * @brief Register the task to notify when a message arrives for a core.
+ *
+ * The receiver then blocks on ulTaskNotifyTake() instead of polling:
+ *
+ *   core_mailbox_set_wakeup(1, xTaskGetCurrentTaskHandle());
+ *   for (;;) {
+ *       ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+ *       while (core_mailbox_try_recv(&msg)) { ... }
+ *   }
+ *
+ * Pass NULL to unregister (sender falls back to fire-and-forget).
+ *
+ * @param core    Core whose arrivals should wake the task (0 or 1)
+ * @param task    Receiver task handle, or NULL
+ */
+void core_mailbox_set_wakeup(unsigned core, TaskHandle_t task);
+
+/**
+ * @brief Messages rejected because the ring toward dest_core was full.
+ */
+uint32_t core_mailbox_dropped(unsigned dest_core);
+
+/**
+ * @brief Messages currently pending toward dest_core.
+ */
+unsigned core_mailbox_pending(unsigned dest_core);
+
+#endif /* CORE_MAILBOX_H */
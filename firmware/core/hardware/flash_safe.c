@@ -4,10 +4,16 @@
 #include "pico/flash.h"    /* flash_safe_execute() */
 #include "hardware/watchdog.h"  /* watchdog_update() — BB4: feed before flash op */
 #include "hardware/sync.h"      /* save_and_disable_interrupts() */
+#include "hardware/timer.h"     /* timer_hw->timerawl — lockout accounting */
 #include "FreeRTOS.h"
 #include "task.h"
 #include <stdio.h>
 
+/* Lockout accounting — read lock-free by the telemetry supervisor
+ * (single aligned words, atomic on M0+). */
+static volatile uint32_t s_op_count;
+static volatile uint32_t s_busy_us;
+
 bool flash_safe_op(void (*func)(void *), void *param) {
     // BB4: Feed the watchdog before potentially long flash operations.
     // Flash erase can take 2-5ms per sector. If the watchdog is active
@@ -15,6 +21,9 @@ bool flash_safe_op(void (*func)(void *), void *param) {
     // watchdog_update() is safe to call even if watchdog is not enabled.
     watchdog_update();
 
+    uint32_t t0 = timer_hw->timerawl;
+    s_op_count++;
+
     // BB5 FIX: Before the FreeRTOS scheduler starts, Core 1 is not launched
     // (FreeRTOS SMP starts Core 1 in vTaskStartScheduler). The Pico SDK's
     // flash_safe_execute() with FREERTOS_SMP tries to create a lockout task
@@ -27,6 +36,7 @@ bool flash_safe_op(void (*func)(void *), void *param) {
         uint32_t save = save_and_disable_interrupts();
         func(param);
         restore_interrupts(save);
+        s_busy_us += timer_hw->timerawl - t0;
         return true;
     }
 
@@ -38,9 +48,18 @@ bool flash_safe_op(void (*func)(void *), void *param) {
     //
     // Returns PICO_OK (0) on success.
     int result = flash_safe_execute(func, param, UINT32_MAX);
+    s_busy_us += timer_hw->timerawl - t0;
     if (result != 0) {
         printf("[flash_safe] flash_safe_execute failed: %d\n", result);
         return false;
     }
     return true;
 }
+
+uint32_t flash_safe_op_count(void) {
+    return s_op_count;
+}
+
+uint32_t flash_safe_busy_us(void) {
+    return s_busy_us;
+}
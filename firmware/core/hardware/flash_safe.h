@@ -20,4 +20,21 @@
  */
 bool flash_safe_op(void (*func)(void *), void *param);
 
+/**
+ * @brief Cumulative number of flash_safe_op() calls since boot.
+ *
+ * Every call is a dual-core lockout window — the telemetry core-load
+ * packet reports the per-window delta so task-placement decisions can
+ * see how often both cores were frozen.
+ */
+uint32_t flash_safe_op_count(void);
+
+/**
+ * @brief Cumulative microseconds spent inside flash_safe_op().
+ *
+ * Measured around the whole operation (lockout + erase/program + XIP
+ * restore) with the 1MHz hardware timer.
+ */
+uint32_t flash_safe_busy_us(void);
+
 #endif /* FLASH_SAFE_H */
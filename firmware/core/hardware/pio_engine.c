@@ -0,0 +1,216 @@
+// firmware/core/hardware/pio_engine.c
+#include "pico/stdlib.h"  /* Must be first — sets up platform macros */
+#include "pio_engine.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include <string.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * DMA IRQ Dispatch
+ *
+ * All engines share DMA_IRQ_0 through one shared handler; each engine
+ * registers its two channels in s_engines so the handler can route the
+ * per-channel completion flag to the right callback. Registration is
+ * only mutated with the IRQ disabled.
+ * ========================================================================= */
+
+/** Engines with an active stream (one per SM, 8 SMs total on RP2040). */
+#define MAX_ACTIVE_ENGINES  8
+
+static pio_engine_t *s_engines[MAX_ACTIVE_ENGINES];
+static bool s_irq_installed;
+
+static void _pio_engine_dma_irq(void) {
+    for (unsigned e = 0; e < MAX_ACTIVE_ENGINES; e++) {
+        pio_engine_t *eng = s_engines[e];
+        if (eng == NULL) continue;
+
+        for (unsigned i = 0; i < 2; i++) {
+            int chan = eng->dma_chan[i];
+            if (!dma_channel_get_irq0_status(chan)) continue;
+            dma_channel_acknowledge_irq0(chan);
+
+            /* The chained partner is already streaming the other
+             * buffer. Re-arm THIS channel for its next turn (the
+             * chain trigger reuses the current read/write address
+             * and count), then hand the buffer to the caller. */
+            if (eng->is_tx) {
+                dma_channel_set_read_addr(chan, eng->buf[i], false);
+            } else {
+                dma_channel_set_write_addr(chan, eng->buf[i], false);
+            }
+            dma_channel_set_trans_count(chan, eng->words, false);
+
+            if (eng->cb != NULL) {
+                eng->cb(i, eng->user);
+            }
+        }
+    }
+}
+
+/* =========================================================================
+ * Program / State Machine Lifecycle
+ * ========================================================================= */
+
+bool pio_engine_claim(pio_engine_t *eng, const pio_program_t *program) {
+    memset(eng, 0, sizeof(*eng));
+    eng->dma_chan[0] = eng->dma_chan[1] = -1;
+
+    /* First PIO block with instruction memory AND a free SM wins */
+    PIO blocks[2] = { pio0, pio1 };
+    for (unsigned b = 0; b < 2; b++) {
+        if (!pio_can_add_program(blocks[b], program)) continue;
+        int sm = pio_claim_unused_sm(blocks[b], false);
+        if (sm < 0) continue;
+
+        eng->pio = blocks[b];
+        eng->sm = (uint)sm;
+        eng->offset = pio_add_program(blocks[b], program);
+        eng->program = program;
+
+        printf("[pio_engine] Claimed pio%u sm%u, program at offset %u\n",
+               b, eng->sm, eng->offset);
+        return true;
+    }
+
+    printf("[pio_engine] No PIO block has room (%u instrs)\n",
+           program->length);
+    return false;
+}
+
+void pio_engine_release(pio_engine_t *eng) {
+    if (eng->pio == NULL) return;
+
+    pio_engine_stream_stop(eng);
+    pio_sm_set_enabled(eng->pio, eng->sm, false);
+    pio_remove_program(eng->pio, eng->program, eng->offset);
+    pio_sm_unclaim(eng->pio, eng->sm);
+    eng->pio = NULL;
+}
+
+void pio_engine_start(pio_engine_t *eng) {
+    pio_sm_set_enabled(eng->pio, eng->sm, true);
+}
+
+void pio_engine_stop(pio_engine_t *eng) {
+    pio_sm_set_enabled(eng->pio, eng->sm, false);
+}
+
+/* =========================================================================
+ * DMA Streaming
+ * ========================================================================= */
+
+/**
+ * @brief Shared TX/RX stream setup — two chained channels, ping-pong.
+ */
+static bool _stream_start(pio_engine_t *eng, uint32_t *buf_a, uint32_t *buf_b,
+                          uint32_t words, bool is_tx,
+                          pio_engine_cb_t cb, void *user) {
+    if (eng->streaming) return false;
+
+    int chan_a = dma_claim_unused_channel(false);
+    int chan_b = dma_claim_unused_channel(false);
+    if (chan_a < 0 || chan_b < 0) {
+        if (chan_a >= 0) dma_channel_unclaim(chan_a);
+        if (chan_b >= 0) dma_channel_unclaim(chan_b);
+        printf("[pio_engine] No free DMA channel pair\n");
+        return false;
+    }
+
+    eng->dma_chan[0] = chan_a;
+    eng->dma_chan[1] = chan_b;
+    eng->buf[0] = buf_a;
+    eng->buf[1] = buf_b;
+    eng->words = words;
+    eng->is_tx = is_tx;
+    eng->cb = cb;
+    eng->user = user;
+
+    for (unsigned i = 0; i < 2; i++) {
+        int chan = eng->dma_chan[i];
+        int partner = eng->dma_chan[i ^ 1];
+
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_dreq(&c, pio_get_dreq(eng->pio, eng->sm, is_tx));
+        channel_config_set_read_increment(&c, is_tx);
+        channel_config_set_write_increment(&c, !is_tx);
+        channel_config_set_chain_to(&c, (uint)partner);
+
+        volatile void *fifo = is_tx ? (volatile void *)&eng->pio->txf[eng->sm]
+                                    : (volatile void *)&eng->pio->rxf[eng->sm];
+        dma_channel_configure(
+            chan, &c,
+            is_tx ? fifo : (volatile void *)eng->buf[i],    /* write */
+            is_tx ? (const void *)eng->buf[i] : fifo,       /* read */
+            words,
+            false
+        );
+        dma_channel_set_irq0_enabled(chan, true);
+    }
+
+    /* Register with the shared DMA_IRQ_0 dispatcher */
+    irq_set_enabled(DMA_IRQ_0, false);
+    unsigned slot;
+    for (slot = 0; slot < MAX_ACTIVE_ENGINES; slot++) {
+        if (s_engines[slot] == NULL) {
+            s_engines[slot] = eng;
+            break;
+        }
+    }
+    if (!s_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, _pio_engine_dma_irq,
+                               PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        s_irq_installed = true;
+    }
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    if (slot == MAX_ACTIVE_ENGINES) {
+        /* All 8 SMs streaming already — cannot happen with one engine
+         * per SM, but fail closed rather than lose completions. */
+        pio_engine_stream_stop(eng);
+        return false;
+    }
+
+    eng->streaming = true;
+    dma_channel_start((uint)eng->dma_chan[0]);
+    return true;
+}
+
+bool pio_engine_tx_start(pio_engine_t *eng, uint32_t *buf_a, uint32_t *buf_b,
+                         uint32_t words, pio_engine_cb_t cb, void *user) {
+    return _stream_start(eng, buf_a, buf_b, words, true, cb, user);
+}
+
+bool pio_engine_rx_start(pio_engine_t *eng, uint32_t *buf_a, uint32_t *buf_b,
+                         uint32_t words, pio_engine_cb_t cb, void *user) {
+    return _stream_start(eng, buf_a, buf_b, words, false, cb, user);
+}
+
+void pio_engine_stream_stop(pio_engine_t *eng) {
+    if (eng->dma_chan[0] < 0 && eng->dma_chan[1] < 0) return;
+
+    irq_set_enabled(DMA_IRQ_0, false);
+    for (unsigned slot = 0; slot < MAX_ACTIVE_ENGINES; slot++) {
+        if (s_engines[slot] == eng) s_engines[slot] = NULL;
+    }
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    for (unsigned i = 0; i < 2; i++) {
+        int chan = eng->dma_chan[i];
+        if (chan < 0) continue;
+        /* Break the chain first so the partner cannot re-trigger the
+         * channel between abort and unclaim. */
+        dma_channel_config c = dma_get_channel_config((uint)chan);
+        channel_config_set_chain_to(&c, (uint)chan);   /* Self = no chain */
+        dma_channel_set_config((uint)chan, &c, false);
+        dma_channel_set_irq0_enabled(chan, false);
+        dma_channel_abort(chan);
+        dma_channel_acknowledge_irq0(chan);
+        dma_channel_unclaim(chan);
+        eng->dma_chan[i] = -1;
+    }
+
+    eng->streaming = false;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file pio_engine.h
+ * @brief PIO-backed high-speed I/O engine — program load + DMA streaming.
+ *
+ * gpio_hal covers task-speed pin work; anything at signal rate
+ * (quadrature decode, pulse capture, WS2812 streams) bit-banged from a
+ * task burns a core. The engine runs such workloads on a PIO state
+ * machine with DMA moving the samples, so the CPU cost per sample is
+ * zero — cores are only touched once per BUFFER at the completion
+ * callback.
+ *
+ * Split of responsibilities:
+ *   - The engine allocates a PIO block/state machine, loads the
+ *     program, and owns the DMA plumbing (two channels per direction,
+ *     chained into a ping-pong ring over two caller buffers).
+ *   - The CALLER configures the state machine (pins, shift setup,
+ *     clock divider) via the pio/sm/offset fields after claiming —
+ *     only the program knows what its pins and autopush setup mean.
+ *
+ * Typical TX use (WS2812-style stream):
+ *
+ *   static pio_engine_t eng;
+ *   static uint32_t buf_a[64], buf_b[64];
+ *   pio_engine_claim(&eng, &ws2812_program);
+ *   ...pio_sm_init(eng.pio, eng.sm, eng.offset, &cfg)...
+ *   pio_engine_start(&eng);
+ *   pio_engine_tx_start(&eng, buf_a, buf_b, 64, _refill_cb, NULL);
+ *
+ * The callback runs in DMA IRQ context on the core that called
+ * *_start — keep it to refilling/consuming the handed-over buffer
+ * (the other buffer is streaming meanwhile, one full buffer period
+ * of slack).
+ */
+
+#ifndef PIO_ENGINE_H
+#define PIO_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+
+/* =========================================================================
+ * Types
+ * ========================================================================= */
+
+/**
+ * @brief Buffer-completion callback.
+ *
+ * TX: buffer buf_index has fully drained into the PIO FIFO — refill it
+ * before the other buffer finishes. RX: buffer buf_index is full —
+ * consume it before the other buffer fills.
+ *
+ * ⚠️ Runs in DMA IRQ context. No blocking calls; FreeRTOS *FromISR
+ * APIs only (e.g. hand the buffer to a task via task notification or
+ * core_mailbox_try_send()).
+ *
+ * @param buf_index  0 or 1 — which of the two buffers completed
+ * @param user       Opaque pointer from *_start
+ */
+typedef void (*pio_engine_cb_t)(unsigned buf_index, void *user);
+
+/**
+ * @brief One claimed state machine plus its DMA plumbing.
+ *
+ * Caller-allocated (static storage, like every handle in this tree).
+ * pio/sm/offset are valid after pio_engine_claim() and are meant to be
+ * read for state-machine configuration; everything else is internal.
+ */
+typedef struct {
+    PIO  pio;                   /**< PIO block the program landed in */
+    uint sm;                    /**< Claimed state machine (0-3) */
+    uint offset;                /**< Instruction memory load offset */
+    const pio_program_t *program;
+
+    /* Internal — DMA ping-pong state */
+    int      dma_chan[2];       /* One channel per buffer, chained */
+    uint32_t *buf[2];
+    uint32_t words;
+    bool     is_tx;
+    bool     streaming;
+    pio_engine_cb_t cb;
+    void     *user;
+} pio_engine_t;
+
+/* =========================================================================
+ * Program / State Machine Lifecycle
+ * ========================================================================= */
+
+/**
+ * @brief Load a PIO program and claim a free state machine for it.
+ *
+ * Tries pio0 then pio1 for instruction-memory space and a free SM.
+ * On success eng->pio/sm/offset identify the claim; configure and
+ * enable the SM through them, then pio_engine_start().
+ *
+ * @param eng      Caller-allocated engine handle (zeroed internally)
+ * @param program  Assembled program (from pioasm's generated header)
+ * @return true on success, false if no PIO block has room
+ */
+bool pio_engine_claim(pio_engine_t *eng, const pio_program_t *program);
+
+/**
+ * @brief Release the state machine, DMA channels, and program memory.
+ *
+ * Stops any active stream first. The handle may be reused with
+ * pio_engine_claim() afterwards.
+ */
+void pio_engine_release(pio_engine_t *eng);
+
+/** @brief Enable the claimed state machine (after caller config). */
+void pio_engine_start(pio_engine_t *eng);
+
+/** @brief Disable the claimed state machine (FIFOs keep their data). */
+void pio_engine_stop(pio_engine_t *eng);
+
+/* =========================================================================
+ * DMA Streaming — double-buffered, zero CPU per sample
+ * ========================================================================= */
+
+/**
+ * @brief Start continuous DMA feed of the TX FIFO from two buffers.
+ *
+ * buf_a streams first; when it drains, the chained second channel
+ * starts buf_b with no gap while the callback hands buf_a back for
+ * refill. The ring runs until pio_engine_stream_stop().
+ *
+ * Both buffers must stay valid for the stream's lifetime and hold
+ * words × 4 bytes (transfers are 32-bit — match the SM's shift setup).
+ *
+ * @param eng    Claimed engine with the SM already configured/enabled
+ * @param buf_a  First buffer (index 0 in the callback)
+ * @param buf_b  Second buffer (index 1), pre-filled like buf_a
+ * @param words  32-bit words per buffer
+ * @param cb     Refill callback (IRQ context), NULL for free-running
+ * @param user   Opaque pointer passed to cb
+ * @return true if the stream started, false if no 2 DMA channels free
+ *         or a stream is already active on this engine
+ */
+bool pio_engine_tx_start(pio_engine_t *eng, uint32_t *buf_a, uint32_t *buf_b,
+                         uint32_t words, pio_engine_cb_t cb, void *user);
+
+/**
+ * @brief Start continuous DMA drain of the RX FIFO into two buffers.
+ *
+ * Same ping-pong scheme as TX: the callback reports each buffer as it
+ * FILLS, with one full buffer period to consume it before overwrite.
+ *
+ * @return true if the stream started (same failure cases as TX)
+ */
+bool pio_engine_rx_start(pio_engine_t *eng, uint32_t *buf_a, uint32_t *buf_b,
+                         uint32_t words, pio_engine_cb_t cb, void *user);
+
+/**
+ * @brief Stop the active stream and free its DMA channels.
+ *
+ * Aborts mid-buffer; the state machine itself keeps running (stop it
+ * separately with pio_engine_stop() if the program should halt).
+ */
+void pio_engine_stream_stop(pio_engine_t *eng);
+
+#endif /* PIO_ENGINE_H */
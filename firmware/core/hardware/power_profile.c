@@ -0,0 +1,86 @@
+// firmware/core/hardware/power_profile.c
+#include "pico/stdlib.h"  /* Must be first — sets up platform macros */
+#include "power_profile.h"
+#include "hardware/timer.h"     /* timer_hw->timerawl */
+#include "pico/platform.h"      /* get_core_num(), __wfi() */
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+
+/* =========================================================================
+ * Module State
+ * ========================================================================= */
+
+static power_profile_t s_profile = POWER_PROFILE_FULL;
+
+/* Per-core WFI sleep accumulators — each written only by the owning
+ * core's idle hook, read lock-free by the telemetry supervisor
+ * (single aligned words, atomic on M0+). */
+static volatile uint32_t s_sleep_us[2];
+
+/* =========================================================================
+ * Idle Hooks — both cores doze in WFI between ready tasks
+ *
+ * V11 SMP: the core running the "active" idle task calls
+ * vApplicationIdleHook(), the other core's passive idle task calls
+ * vApplicationPassiveIdleHook(). Both route here so each core sleeps
+ * until its next interrupt (tick, alarm, DMA, SIO IPC) instead of
+ * spinning the idle loop. The hook must not block — WFI is exactly
+ * the allowed kind of wait (resumes on interrupt, no scheduler call).
+ * ========================================================================= */
+
+#if POWER_IDLE_DOZE
+static void _idle_doze(void) {
+    unsigned core = get_core_num();
+    uint32_t t0 = timer_hw->timerawl;
+    __wfi();
+    s_sleep_us[core] += timer_hw->timerawl - t0;
+}
+
+void vApplicationIdleHook(void) {
+    _idle_doze();
+}
+
+void vApplicationPassiveIdleHook(void) {
+    _idle_doze();
+}
+#endif /* POWER_IDLE_DOZE */
+
+/* =========================================================================
+ * Clock Profiles
+ * ========================================================================= */
+
+bool power_profile_set(power_profile_t profile) {
+    if (profile == s_profile) return true;
+
+    uint32_t khz = (profile == POWER_PROFILE_LOW) ? POWER_SYSCLK_LOW_KHZ
+                                                  : POWER_SYSCLK_FULL_KHZ;
+
+    /* set_sys_clock_khz revalidates PLL settings and reconfigures
+     * clk_peri; required=false so an unreachable frequency fails
+     * cleanly instead of asserting. */
+    if (!set_sys_clock_khz(khz, false)) {
+        printf("[power] sysclk %lukHz rejected by PLL config\n",
+               (unsigned long)khz);
+        return false;
+    }
+
+    s_profile = profile;
+    printf("[power] Profile %s, sysclk=%lukHz\n",
+           (profile == POWER_PROFILE_LOW) ? "LOW" : "FULL",
+           (unsigned long)khz);
+    return true;
+}
+
+power_profile_t power_profile_get(void) {
+    return s_profile;
+}
+
+uint32_t power_profile_sleep_us(unsigned core) {
+#if POWER_IDLE_DOZE
+    return (core < 2) ? s_sleep_us[core] : 0;
+#else
+    (void)core;
+    return 0;
+#endif
+}
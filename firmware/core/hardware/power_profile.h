@@ -0,0 +1,92 @@
+/**
+ * @file power_profile.h
+ * @brief Idle power management — WFI dozing + dynamic clock profiles.
+ *
+ * The RP2040 FreeRTOS SMP port has no portSUPPRESS_TICKS_AND_SLEEP, so
+ * true tickless idle (stopping the 1kHz tick) is not available without
+ * patching the port. What IS available covers most of the power gap:
+ *
+ *   - Idle dozing: both cores' idle tasks execute WFI through the
+ *     FreeRTOS idle hooks, so an idle core sleeps until the next
+ *     interrupt instead of spinning the idle loop. The tick still
+ *     fires, but each wake is interrupt entry + hook, not 1ms of
+ *     busy-waiting — and time asleep is accounted per core for the
+ *     telemetry vitals packet (sleep_us field).
+ *
+ *   - Clock profiles: drop sysclk from 125MHz to 48MHz while the
+ *     system is between bursts of work, cutting active AND idle
+ *     current roughly proportionally. The 1MHz timebase (watchdog
+ *     tick) is unaffected, so TIMERAWL timestamps, runtime stats,
+ *     and FreeRTOS tick timing stay correct across switches.
+ *
+ * Wakeup latency: unchanged — interrupts (tick, alarms, DMA) exit WFI
+ * in a few cycles, so the watchdog monitor's WDG_CHECK_PERIOD_MS
+ * cadence is unaffected. A clock-profile switch itself takes tens of
+ * microseconds (PLL relock); callers that cannot tolerate that bound
+ * simply stay in POWER_PROFILE_FULL.
+ *
+ * ⚠️ POWER_PROFILE_LOW reconfigures clk_peri: re-derived UART baud is
+ * handled by the SDK, but anything hand-configured from clk_peri/clk_sys
+ * must be re-programmed by its owner after a switch.
+ */
+
+#ifndef POWER_PROFILE_H
+#define POWER_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* =========================================================================
+ * Configuration
+ * ========================================================================= */
+
+/** Sysclk for each profile (kHz). 48MHz is the lowest clean divider
+ *  that keeps USB-capable PLL settings and comfortable UART margins. */
+#define POWER_SYSCLK_FULL_KHZ   125000
+#define POWER_SYSCLK_LOW_KHZ    48000
+
+/** Compile the WFI doze out entirely (debug: some SWD probes dislike
+ *  cores sleeping in WFI during flash breakpoints). */
+#ifndef POWER_IDLE_DOZE
+#define POWER_IDLE_DOZE         1
+#endif
+
+/* =========================================================================
+ * Types
+ * ========================================================================= */
+
+typedef enum {
+    POWER_PROFILE_FULL = 0,     /**< 125MHz sysclk — default */
+    POWER_PROFILE_LOW  = 1,     /**< 48MHz sysclk — idle/battery mode */
+} power_profile_t;
+
+/* =========================================================================
+ * Public API
+ * ========================================================================= */
+
+/**
+ * @brief Switch the system clock profile.
+ *
+ * Safe to call from any task; the PLL relock stalls both cores for
+ * tens of microseconds. No-op if the profile is already active.
+ *
+ * @param profile  Target profile
+ * @return true on success (clock accepted by the PLL configuration)
+ */
+bool power_profile_set(power_profile_t profile);
+
+/** @brief Currently active clock profile. */
+power_profile_t power_profile_get(void);
+
+/**
+ * @brief Cumulative microseconds one core has spent asleep in WFI.
+ *
+ * Accumulated by the idle hooks; read lock-free by the telemetry
+ * supervisor. Returns 0 for an out-of-range core or when
+ * POWER_IDLE_DOZE is 0.
+ *
+ * @param core  0 or 1
+ */
+uint32_t power_profile_sleep_us(unsigned core);
+
+#endif /* POWER_PROFILE_H */
@@ -0,0 +1,250 @@
+/**
+ * @file bench_logging.c
+ * @brief Host microbenchmarks — varint encoders + log/telemetry write paths.
+ *
+ * Compiles the REAL firmware translation units (log_core.c, log_ring.c,
+ * log_varint.c, telemetry_driver.c) against the mock headers in
+ * ../mocks and measures:
+ *
+ *   1. log_varint_encode_i32 / _float cost across value distributions
+ *   2. End-to-end log packets/second for 0–8 argument calls
+ *      (encode + ring enqueue + flusher drain to the mock RTT sink)
+ *   3. Encoded-bytes-per-packet statistics per argument count
+ *   4. telemetry_write_packet throughput at snapshot/delta sizes
+ *
+ * Output is one JSON object per line on stdout. The byte-statistics
+ * fields are deterministic (fixed PRNG seed) and safe to diff in CI;
+ * the ns/op fields are machine-dependent and should be compared as
+ * ratios against a baseline run on the same machine.
+ *
+ * Exit code is non-zero if any packet was dropped (the harness flushes
+ * often enough that a drop means a ring accounting bug).
+ */
+
+#include "ai_log.h"
+#include "log_ring.h"
+#include "log_varint.h"
+#include "telemetry.h"
+#include "SEGGER_RTT.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Defined in telemetry_driver.c (repo-wide extern-decl pattern) */
+extern unsigned telemetry_write_packet(const void *data, unsigned length);
+
+/* =========================================================================
+ * Harness Utilities
+ * ========================================================================= */
+
+#define VALUE_POOL_SIZE     4096u   /* Power of two — cheap index mask */
+#define VARINT_ITERS        4000000u
+#define PACKET_ITERS        400000u
+#define FLUSH_EVERY         16u     /* Packets between ring drains */
+
+static uint64_t _now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* xorshift32 — deterministic value pools, identical on every run/host */
+static uint32_t s_rng = 0x12345678u;
+static uint32_t _rand32(void) {
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return s_rng = x;
+}
+
+/** Accumulated so the compiler cannot discard the encode loops. */
+static uint32_t s_sink;
+
+/* =========================================================================
+ * 1. Varint Encoder Benchmarks
+ * ========================================================================= */
+
+/** Fill a pool of int32 values bounded to ±(2^bits - 1). */
+static void _fill_i32_pool(int32_t *pool, unsigned bits) {
+    uint32_t mask = (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1u);
+    for (unsigned i = 0; i < VALUE_POOL_SIZE; i++) {
+        int32_t v = (int32_t)(_rand32() & mask);
+        pool[i] = (_rand32() & 1u) ? -v : v;
+    }
+}
+
+static void _bench_varint_i32(const char *name, unsigned bits) {
+    static int32_t pool[VALUE_POOL_SIZE];
+    _fill_i32_pool(pool, bits);
+
+    uint8_t buf[8];
+    uint64_t bytes = 0;
+
+    uint64_t t0 = _now_ns();
+    for (unsigned i = 0; i < VARINT_ITERS; i++) {
+        unsigned n = log_varint_encode_i32(pool[i & (VALUE_POOL_SIZE - 1)], buf);
+        bytes += n;
+        s_sink += buf[0];
+    }
+    uint64_t dt = _now_ns() - t0;
+
+    printf("{\"bench\": \"varint_i32_%s\", \"n\": %u, \"ns_per_op\": %.2f, "
+           "\"ops_per_sec\": %.0f, \"bytes_per_value_mean\": %.4f}\n",
+           name, VARINT_ITERS, (double)dt / VARINT_ITERS,
+           VARINT_ITERS / ((double)dt / 1e9),
+           (double)bytes / VARINT_ITERS);
+}
+
+static void _bench_varint_float(void) {
+    static float pool[VALUE_POOL_SIZE];
+    for (unsigned i = 0; i < VALUE_POOL_SIZE; i++) {
+        pool[i] = (float)(int32_t)_rand32() / 1000.0f;
+    }
+
+    uint8_t buf[8];
+
+    uint64_t t0 = _now_ns();
+    for (unsigned i = 0; i < VARINT_ITERS; i++) {
+        log_varint_encode_float(pool[i & (VALUE_POOL_SIZE - 1)], buf);
+        s_sink += buf[0];
+    }
+    uint64_t dt = _now_ns() - t0;
+
+    printf("{\"bench\": \"varint_float\", \"n\": %u, \"ns_per_op\": %.2f, "
+           "\"ops_per_sec\": %.0f, \"bytes_per_value_mean\": 4.0000}\n",
+           VARINT_ITERS, (double)dt / VARINT_ITERS,
+           VARINT_ITERS / ((double)dt / 1e9));
+}
+
+/* =========================================================================
+ * 2+3. End-to-End Log Packet Benchmarks
+ * ========================================================================= */
+
+/**
+ * @brief Measure packets/second and bytes/packet for one argument count.
+ *
+ * Arguments mix small ints (typical: loop counters, error codes) with
+ * one float per call when argc ≥ 4, mirroring real LOG_xxx usage.
+ * The ring is drained every FLUSH_EVERY packets, so the measured cost
+ * includes the producer path AND the amortized flusher drain — the
+ * same work the target performs, minus the real RTT memcpy.
+ */
+static int _bench_log_packets(uint8_t argc) {
+    static int32_t pool[VALUE_POOL_SIZE];
+    _fill_i32_pool(pool, 14);   /* Mostly 1-2 byte varints, like real logs */
+
+    ai_log_arg_t args[AI_LOG_MAX_ARGS];
+    mock_rtt_reset();
+
+    uint64_t t0 = _now_ns();
+    for (unsigned i = 0; i < PACKET_ITERS; i++) {
+        if (argc == 0) {
+            _ai_log_write_simple(AI_LOG_LEVEL_INFO, 0xDEADBEEFu);
+        } else {
+            for (uint8_t a = 0; a < argc; a++) {
+                if (argc >= 4 && a == 3) {
+                    args[a] = AI_LOG_ARG_F((float)pool[(i + a) & (VALUE_POOL_SIZE - 1)]);
+                } else {
+                    args[a] = AI_LOG_ARG_I(pool[(i + a) & (VALUE_POOL_SIZE - 1)]);
+                }
+            }
+            _ai_log_write(AI_LOG_LEVEL_INFO, 0xDEADBEEFu, args, argc);
+        }
+        if ((i & (FLUSH_EVERY - 1)) == (FLUSH_EVERY - 1)) {
+            log_ring_flush();
+        }
+    }
+    log_ring_flush();
+    uint64_t dt = _now_ns() - t0;
+
+    if (log_ring_dropped() != 0) {
+        fprintf(stderr, "[bench] FAIL: %u packets dropped at argc=%u\n",
+                (unsigned)log_ring_dropped(), argc);
+        return 1;
+    }
+
+    /* Each RTT write is [core|seq:1][packet] — strip the prefix byte
+     * to report the encoded packet size itself. */
+    const mock_rtt_stats_t *st = mock_rtt_stats(1);
+    printf("{\"bench\": \"log_packet_argc%u\", \"n\": %u, \"ns_per_op\": %.2f, "
+           "\"packets_per_sec\": %.0f, \"bytes_per_packet_mean\": %.4f, "
+           "\"bytes_per_packet_min\": %u, \"bytes_per_packet_max\": %u}\n",
+           argc, PACKET_ITERS, (double)dt / PACKET_ITERS,
+           PACKET_ITERS / ((double)dt / 1e9),
+           (double)st->bytes / st->writes - 1.0,
+           st->min_len - 1, st->max_len - 1);
+    return 0;
+}
+
+/* =========================================================================
+ * 4. Telemetry Packet Writer Benchmark
+ * ========================================================================= */
+
+/**
+ * @brief Telemetry write path at a given packet size.
+ *
+ * Each iteration perturbs a few bytes of the packet (like a real task
+ * table between cycles) so the XOR-delta batcher sees realistic
+ * near-repetitive input rather than a perfectly constant packet.
+ * wire_bytes_per_packet vs packet_bytes is the compression ratio the
+ * 512B RTT buffer gains in history depth.
+ */
+static void _bench_telemetry(const char *name, unsigned packet_len) {
+    static uint8_t packet[512];
+    for (unsigned i = 0; i < packet_len; i++) packet[i] = (uint8_t)_rand32();
+    packet[0] = TELEMETRY_PKT_SYSTEM_VITALS;
+
+    mock_rtt_reset();
+
+    uint64_t t0 = _now_ns();
+    for (unsigned i = 0; i < PACKET_ITERS; i++) {
+        /* Touch 3 bytes per cycle — CPU%, runtime, one stack HWM */
+        packet[5 + (i % (packet_len - 8))] = (uint8_t)i;
+        packet[packet_len - 2] = (uint8_t)(i >> 3);
+        packet[packet_len - 7] = (uint8_t)(i >> 5);
+        s_sink += telemetry_write_packet(packet, packet_len);
+    }
+    telemetry_flush();
+    uint64_t dt = _now_ns() - t0;
+
+    const mock_rtt_stats_t *st = mock_rtt_stats(TELEMETRY_RTT_CHANNEL);
+    printf("{\"bench\": \"telemetry_write_%s\", \"n\": %u, \"ns_per_op\": %.2f, "
+           "\"packets_per_sec\": %.0f, \"packet_bytes\": %u, "
+           "\"wire_bytes_per_packet\": %.4f, \"compression_ratio\": %.2f}\n",
+           name, PACKET_ITERS, (double)dt / PACKET_ITERS,
+           PACKET_ITERS / ((double)dt / 1e9), packet_len,
+           (double)st->bytes / PACKET_ITERS,
+           (double)packet_len * PACKET_ITERS / (double)st->bytes);
+}
+
+/* =========================================================================
+ * Main
+ * ========================================================================= */
+
+int main(void) {
+    /* Init messages go to stderr-adjacent stdout; keep them greppable
+     * apart from the JSON by their non-{ prefix. */
+    ai_log_init();
+    telemetry_init();
+
+    _bench_varint_i32("small", 6);      /* ±63     → 1-byte varints */
+    _bench_varint_i32("medium", 13);    /* ±8191   → 2-byte varints */
+    _bench_varint_i32("large", 27);     /* ±2^27   → 4-byte varints */
+    _bench_varint_i32("uniform", 32);   /* Full range, 1-5 bytes */
+    _bench_varint_float();
+
+    int rc = 0;
+    for (uint8_t argc = 0; argc <= AI_LOG_MAX_ARGS; argc++) {
+        rc |= _bench_log_packets(argc);
+    }
+
+    _bench_telemetry("snapshot", 486);  /* 38B header + 32 × 14B entries */
+    _bench_telemetry("delta", 40);      /* Typical steady-state delta */
+
+    /* Keep the sink observable so the encode loops cannot be elided */
+    fprintf(stderr, "[bench] done, sink=0x%08x\n", s_sink);
+    return rc;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host mock — minimal FreeRTOS types/macros for host compilation.
+ *
+ * Just enough to compile the logging and telemetry translation units on
+ * a desktop. Critical sections are no-ops: the host benchmarks are
+ * single-threaded, and making the lock free keeps the measurement on
+ * the encode path rather than on a pthread mutex the target never uses.
+ */
+
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint16_t StackType_t;
+typedef void    *TaskHandle_t;
+typedef void   (*TaskFunction_t)(void *);
+
+#define pdPASS                      ((BaseType_t)1)
+#define pdFAIL                      ((BaseType_t)0)
+#define pdTRUE                      ((BaseType_t)1)
+#define pdFALSE                     ((BaseType_t)0)
+
+#define configTICK_RATE_HZ          1000
+#define configMINIMAL_STACK_SIZE    256
+#define tskIDLE_PRIORITY            0
+#define pdMS_TO_TICKS(ms)           ((TickType_t)(ms))
+
+/* No-op critical sections — see file banner */
+#define taskENTER_CRITICAL()        do { } while (0)
+#define taskEXIT_CRITICAL()         do { } while (0)
+
+#endif /* MOCK_FREERTOS_H */
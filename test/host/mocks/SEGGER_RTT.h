@@ -0,0 +1,39 @@
+/**
+ * @file SEGGER_RTT.h
+ * @brief Host mock — RTT sink that records per-write statistics.
+ *
+ * Every write is accepted (infinite buffer) and its length is folded
+ * into per-channel counters the benchmark harness reads back, so
+ * encoded-bytes-per-packet statistics come straight from the real
+ * firmware write path rather than a parallel reimplementation.
+ */
+
+#ifndef MOCK_SEGGER_RTT_H
+#define MOCK_SEGGER_RTT_H
+
+#include <stdint.h>
+
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP   0
+#define SEGGER_RTT_MODE_NO_BLOCK_TRIM   1
+#define SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL 2
+
+#define MOCK_RTT_MAX_CHANNELS   4
+
+/** Per-channel write statistics, reset via mock_rtt_reset(). */
+typedef struct {
+    uint64_t bytes;         /* Total bytes accepted */
+    uint64_t writes;        /* Number of write calls */
+    uint32_t min_len;       /* Smallest single write (UINT32_MAX if none) */
+    uint32_t max_len;       /* Largest single write */
+} mock_rtt_stats_t;
+
+int  SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index, const char *name,
+                               void *buffer, unsigned size, unsigned flags);
+unsigned SEGGER_RTT_WriteNoLock(unsigned buffer_index, const void *data,
+                                unsigned num_bytes);
+
+/* Harness-side controls (implemented alongside the stubs) */
+void mock_rtt_reset(void);
+const mock_rtt_stats_t *mock_rtt_stats(unsigned buffer_index);
+
+#endif /* MOCK_SEGGER_RTT_H */
@@ -0,0 +1,14 @@
+/**
+ * @file hardware/sync.h
+ * @brief Host mock — RP2040 interrupt mask stubs (single-threaded host).
+ */
+
+#ifndef MOCK_HARDWARE_SYNC_H
+#define MOCK_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+
+#endif /* MOCK_HARDWARE_SYNC_H */
@@ -0,0 +1,19 @@
+/**
+ * @file hardware/timer.h
+ * @brief Host mock — RP2040 1MHz timer. A fixed counter keeps the
+ *        benchmark byte statistics deterministic across runs.
+ */
+
+#ifndef MOCK_HARDWARE_TIMER_H
+#define MOCK_HARDWARE_TIMER_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t timerawl;
+} mock_timer_hw_t;
+
+static mock_timer_hw_t mock_timer_instance;
+#define timer_hw (&mock_timer_instance)
+
+#endif /* MOCK_HARDWARE_TIMER_H */
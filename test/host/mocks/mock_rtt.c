@@ -0,0 +1,36 @@
+/**
+ * @file mock_rtt.c
+ * @brief Host mock — RTT stub implementation (see mocks/SEGGER_RTT.h).
+ */
+
+#include "SEGGER_RTT.h"
+#include <string.h>
+
+static mock_rtt_stats_t s_stats[MOCK_RTT_MAX_CHANNELS];
+
+int SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index, const char *name,
+                              void *buffer, unsigned size, unsigned flags) {
+    (void)buffer_index; (void)name; (void)buffer; (void)size; (void)flags;
+    return 0;
+}
+
+unsigned SEGGER_RTT_WriteNoLock(unsigned buffer_index, const void *data,
+                                unsigned num_bytes) {
+    (void)data;
+    if (buffer_index >= MOCK_RTT_MAX_CHANNELS) return 0;
+
+    mock_rtt_stats_t *st = &s_stats[buffer_index];
+    st->bytes += num_bytes;
+    st->writes++;
+    if (st->min_len == 0 || num_bytes < st->min_len) st->min_len = num_bytes;
+    if (num_bytes > st->max_len) st->max_len = num_bytes;
+    return num_bytes;  /* Infinite buffer — always accepted */
+}
+
+void mock_rtt_reset(void) {
+    memset(s_stats, 0, sizeof(s_stats));
+}
+
+const mock_rtt_stats_t *mock_rtt_stats(unsigned buffer_index) {
+    return &s_stats[buffer_index % MOCK_RTT_MAX_CHANNELS];
+}
@@ -0,0 +1,12 @@
+/**
+ * @file pico/platform.h
+ * @brief Host mock — core-ID stub. The harness is single-threaded and
+ *        always "runs" on core 0, so both log packets land in ring 0.
+ */
+
+#ifndef MOCK_PICO_PLATFORM_H
+#define MOCK_PICO_PLATFORM_H
+
+static inline unsigned get_core_num(void) { return 0; }
+
+#endif /* MOCK_PICO_PLATFORM_H */
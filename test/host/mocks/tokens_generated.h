@@ -0,0 +1,18 @@
+/**
+ * @file tokens_generated.h
+ * @brief Host mock — stand-in for the gen_tokens.py output.
+ *
+ * The benchmarks measure encode cost, not token lookup, so a fixed
+ * BUILD_ID is fine. A device build regenerates the real header into
+ * firmware/components/logging/include/, which then shadows this one.
+ */
+
+#ifndef MOCK_TOKENS_GENERATED_H
+#define MOCK_TOKENS_GENERATED_H
+
+#include <stdint.h>
+
+#define AI_LOG_BUILD_ID      ((uint32_t)0x00000000)
+#define AI_LOG_TOKEN_COUNT   0
+
+#endif /* MOCK_TOKENS_GENERATED_H */
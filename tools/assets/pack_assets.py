@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""
+Asset region packer — builds the raw-flash image for the XIP asset store.
+
+Packs one or more files into the region format consumed by
+firmware/components/persistence/src/asset_store.c:
+
+    [asset_index_t][asset_entry_t x count][padding to 256B][payloads...]
+
+All integers little-endian. Layout must match asset_store.h:
+    asset_index_t: <IIII  = magic, version, count, index_crc
+    asset_entry_t: <16sIII = name (NUL-padded), offset, length, crc32
+    index_crc  = CRC32 (zlib) over the packed entry table
+    entry crc32 = CRC32 over the payload bytes
+
+Payloads are 4-byte aligned so firmware can cast the XIP pointer to
+word-sized table types directly.
+
+Usage:
+    # Name defaults to the file's stem (truncated to 15 chars)
+    python pack_assets.py --out assets.bin cal_table.bin dac_wave.bin
+
+    # Explicit names with name=path
+    python pack_assets.py --out assets.bin caltab=build/cal.bin
+
+    # Flash it (region offset from fs_config.h: 2MB - 64K - 8K - 64K)
+    picotool load assets.bin -o 0x101DE000
+
+Dependencies: Python 3.10+ stdlib only.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+ASSET_STORE_MAGIC = 0x41534554      # "ASET"
+ASSET_STORE_VERSION = 1
+ASSET_NAME_MAX = 16                 # Including NUL terminator
+ASSET_STORE_MAX_ASSETS = 32
+REGION_SIZE = 64 * 1024             # FS_ASSET_REGION_SIZE
+XIP_REGION_ADDR = 0x101DE000        # XIP_BASE + FS_ASSET_REGION_OFFSET
+
+INDEX_FORMAT = "<IIII"
+ENTRY_FORMAT = "<16sIII"
+PAYLOAD_ALIGN = 4
+HEADER_ALIGN = 256                  # Payloads start on a flash-page boundary
+
+
+def _align(n: int, a: int) -> int:
+    return (n + a - 1) & ~(a - 1)
+
+
+def parse_asset_arg(arg: str) -> tuple[str, Path]:
+    """'name=path' or bare 'path' (name = stem, truncated)."""
+    if "=" in arg:
+        name, _, path = arg.partition("=")
+    else:
+        path = arg
+        name = Path(arg).stem
+    name = name[: ASSET_NAME_MAX - 1]
+    return name, Path(path)
+
+
+def build_region(assets: list[tuple[str, bytes]]) -> bytes:
+    """Assemble the full region image (index + entry table + payloads)."""
+    if len(assets) > ASSET_STORE_MAX_ASSETS:
+        raise ValueError(
+            f"{len(assets)} assets > max {ASSET_STORE_MAX_ASSETS}"
+        )
+
+    index_size = struct.calcsize(INDEX_FORMAT)
+    table_size = len(assets) * struct.calcsize(ENTRY_FORMAT)
+    payload_base = _align(index_size + table_size, HEADER_ALIGN)
+
+    entries = b""
+    payloads = b""
+    offset = payload_base
+    for name, data in assets:
+        entries += struct.pack(
+            ENTRY_FORMAT,
+            name.encode("ascii"),
+            offset,
+            len(data),
+            zlib.crc32(data) & 0xFFFFFFFF,
+        )
+        payloads += data
+        pad = _align(len(data), PAYLOAD_ALIGN) - len(data)
+        payloads += b"\xff" * pad
+        offset += len(data) + pad
+
+    if offset > REGION_SIZE:
+        raise ValueError(
+            f"Image is {offset} bytes — exceeds {REGION_SIZE}B region"
+        )
+
+    index = struct.pack(
+        INDEX_FORMAT,
+        ASSET_STORE_MAGIC,
+        ASSET_STORE_VERSION,
+        len(assets),
+        zlib.crc32(entries) & 0xFFFFFFFF,
+    )
+
+    gap = payload_base - index_size - table_size
+    return index + entries + b"\xff" * gap + payloads
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Build the raw-flash image for the XIP asset store"
+    )
+    parser.add_argument("assets", nargs="+", metavar="[name=]path",
+                        help="Asset files; name defaults to the file stem")
+    parser.add_argument("--out", required=True,
+                        help="Output region image path")
+    parser.add_argument("--json", action="store_true",
+                        help="Emit a JSON summary to stdout")
+    args = parser.parse_args()
+
+    assets = []
+    seen = set()
+    for arg in args.assets:
+        name, path = parse_asset_arg(arg)
+        if name in seen:
+            print(f"Error: duplicate asset name '{name}'", file=sys.stderr)
+            sys.exit(1)
+        seen.add(name)
+        if not path.is_file():
+            print(f"Error: no such file: {path}", file=sys.stderr)
+            sys.exit(1)
+        assets.append((name, path.read_bytes()))
+
+    try:
+        image = build_region(assets)
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    Path(args.out).write_bytes(image)
+
+    if args.json:
+        print(json.dumps({
+            "status": "ok",
+            "out": args.out,
+            "image_bytes": len(image),
+            "region_bytes": REGION_SIZE,
+            "flash_address": f"0x{XIP_REGION_ADDR:08X}",
+            "assets": [
+                {"name": n, "bytes": len(d)} for n, d in assets
+            ],
+        }))
+    else:
+        print(f"Packed {len(assets)} asset(s), {len(image)}/{REGION_SIZE} "
+              f"bytes — flash at 0x{XIP_REGION_ADDR:08X}:")
+        for name, data in assets:
+            print(f"  {name:<15} {len(data)} bytes")
+        print(f"  picotool load {args.out} -o 0x{XIP_REGION_ADDR:08X}")
+
+
+if __name__ == "__main__":
+    main()
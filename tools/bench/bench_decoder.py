@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Bench Decoder — on-target microbenchmark results from RTT Channel 2.
+
+Connects to OpenOCD's RTT Channel 2 (TCP 9092) while the firmware_bench
+image runs, decodes BENCH_PKT_RESULT packets, and prints a result table
+plus one JSON line per benchmark. Exits when the firmware sends its
+end-of-run marker.
+
+Regression checking: pass --baseline with a previous run's JSON file
+(written via --save) and the decoder flags any benchmark whose
+ns_per_op moved more than --threshold percent — re-run after every
+FreeRTOS-Kernel or pico-sdk bump in lib/.
+
+Usage:
+    python bench_decoder.py [--host HOST] [--port PORT]
+    python bench_decoder.py --save baseline.json
+    python bench_decoder.py --baseline baseline.json --threshold 10
+
+Dependencies: Python 3.8+ stdlib only (socket, struct, json, argparse)
+"""
+
+import argparse
+import json
+import socket
+import struct
+import sys
+
+# ===========================================================================
+# Binary Packet Format (must match firmware/bench/main_bench.c)
+# ===========================================================================
+
+# [type:1][id:1][name:12][iters:4][total_us:4][ns_per_op:4][min_us:4][max_us:4]
+PKT_RESULT = 0xB0
+PKT_DONE = 0xB1
+RESULT_FORMAT = "<BB12sIIIII"
+RESULT_SIZE = struct.calcsize(RESULT_FORMAT)  # 34 bytes
+DONE_SIZE = 2
+
+
+def decode_result(data: bytes) -> dict:
+    """Decode one BENCH_PKT_RESULT packet."""
+    (_, bench_id, name, iters, total_us, ns_per_op, min_us, max_us) = (
+        struct.unpack(RESULT_FORMAT, data)
+    )
+    return {
+        "id": bench_id,
+        "name": name.rstrip(b"\x00").decode("ascii", errors="replace"),
+        "iters": iters,
+        "total_us": total_us,
+        "ns_per_op": ns_per_op,
+        "min_us": min_us,
+        "max_us": max_us,
+    }
+
+
+def collect_results(sock: socket.socket) -> list[dict]:
+    """Read the RTT stream until the PKT_DONE marker."""
+    results = []
+    buffer = b""
+    while True:
+        try:
+            data = sock.recv(4096)
+        except socket.timeout:
+            continue
+        if not data:
+            raise ConnectionError("RTT stream closed before PKT_DONE")
+        buffer += data
+
+        offset = 0
+        while offset < len(buffer):
+            pkt_type = buffer[offset]
+            if pkt_type == PKT_RESULT:
+                if offset + RESULT_SIZE > len(buffer):
+                    break
+                results.append(
+                    decode_result(buffer[offset : offset + RESULT_SIZE])
+                )
+                offset += RESULT_SIZE
+            elif pkt_type == PKT_DONE:
+                if offset + DONE_SIZE > len(buffer):
+                    break
+                count = buffer[offset + 1]
+                if count != len(results):
+                    print(
+                        f"[bench_decoder] WARNING: firmware emitted {count} "
+                        f"results, decoded {len(results)}",
+                        file=sys.stderr,
+                    )
+                return results
+            else:
+                offset += 1  # Resync — stray byte in the stream
+
+        buffer = buffer[offset:]
+
+
+def check_regressions(results: list[dict], baseline_path: str,
+                      threshold_pct: float) -> int:
+    """Compare ns_per_op against a saved baseline run.
+
+    Returns the number of benchmarks that regressed beyond threshold.
+    """
+    with open(baseline_path) as f:
+        baseline = {r["name"]: r for r in (json.loads(l) for l in f)}
+
+    regressions = 0
+    for r in results:
+        base = baseline.get(r["name"])
+        if base is None or base["ns_per_op"] == 0:
+            continue
+        delta_pct = 100.0 * (r["ns_per_op"] - base["ns_per_op"]) / base["ns_per_op"]
+        if delta_pct > threshold_pct:
+            regressions += 1
+            print(
+                f"[bench_decoder] REGRESSION {r['name']}: "
+                f"{base['ns_per_op']} → {r['ns_per_op']} ns/op "
+                f"({delta_pct:+.1f}%)",
+                file=sys.stderr,
+            )
+        elif delta_pct < -threshold_pct:
+            print(
+                f"[bench_decoder] improvement {r['name']}: "
+                f"{base['ns_per_op']} → {r['ns_per_op']} ns/op "
+                f"({delta_pct:+.1f}%)",
+                file=sys.stderr,
+            )
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="On-target microbenchmark decoder (RTT Channel 2)"
+    )
+    parser.add_argument(
+        "--host", default="localhost", help="OpenOCD RTT TCP host (default: localhost)"
+    )
+    parser.add_argument(
+        "--port", type=int, default=9092, help="RTT Channel 2 TCP port (default: 9092)"
+    )
+    parser.add_argument(
+        "--save", metavar="FILE", help="Write results as JSON lines (baseline file)"
+    )
+    parser.add_argument(
+        "--baseline", metavar="FILE", help="Previous --save file to compare against"
+    )
+    parser.add_argument(
+        "--threshold", type=float, default=10.0,
+        help="Regression threshold in percent (default: 10)",
+    )
+    args = parser.parse_args()
+
+    print(
+        f"[bench_decoder] Waiting for firmware_bench on "
+        f"{args.host}:{args.port}...",
+        file=sys.stderr,
+    )
+    sock = socket.create_connection((args.host, args.port), timeout=5.0)
+    sock.settimeout(1.0)
+
+    try:
+        results = collect_results(sock)
+    finally:
+        sock.close()
+
+    print(f"{'name':<14} {'iters':>8} {'ns/op':>10} {'min_us':>8} {'max_us':>8}",
+          file=sys.stderr)
+    for r in results:
+        print(
+            f"{r['name']:<14} {r['iters']:>8} {r['ns_per_op']:>10} "
+            f"{r['min_us']:>8} {r['max_us']:>8}",
+            file=sys.stderr,
+        )
+        print(json.dumps(r))
+
+    if args.save:
+        with open(args.save, "w") as f:
+            for r in results:
+                f.write(json.dumps(r) + "\n")
+        print(f"[bench_decoder] Saved {len(results)} results to {args.save}",
+              file=sys.stderr)
+
+    if args.baseline:
+        sys.exit(1 if check_regressions(results, args.baseline,
+                                        args.threshold) else 0)
+
+
+if __name__ == "__main__":
+    main()
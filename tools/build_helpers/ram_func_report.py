@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+SRAM hot-function budget report — parse a GNU ld map file for functions
+placed in RAM via AI_HOT_FUNC (firmware/core/ai_hot.h).
+
+AI_HOT_FUNC expands to the Pico SDK's __not_in_flash_func(), which puts
+each marked function in a .time_critical.<name> input section. The SDK
+linker script gathers those (plus any legacy .ram_func sections) into
+RAM, and crt0 copies them from flash before main(). Every marked
+function therefore permanently costs its code size in SRAM — this script
+prints the per-function and total spend so the set stays deliberate.
+
+Usage:
+  python3 tools/build_helpers/ram_func_report.py build/firmware/app/firmware_app.elf.map
+  python3 tools/build_helpers/ram_func_report.py <map_file> --json
+
+Exit codes:
+  0: Success
+  1: Failure (map file not found / no RAM-function sections matched)
+"""
+
+import argparse
+import json
+import re
+import sys
+from pathlib import Path
+
+# Input-section names the SDK linker script routes to RAM.
+RAM_SECTION_PREFIXES = (".time_critical.", ".ram_func")
+
+# Map-file lines come in two shapes (name split onto its own line when long):
+#   .time_critical.log_ring_write
+#                  0x20000100      0x84 CMakeFiles/.../log_ring.c.obj
+#   .time_critical.foo 0x20000100  0x84 CMakeFiles/.../foo.c.obj
+_ADDR_SIZE_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S+)")
+
+
+def parse_map(map_path):
+    """Return a list of {name, address, size, object} for RAM-placed functions."""
+    entries = []
+    pending_section = None
+
+    with open(map_path, "r", errors="replace") as f:
+        for line in f:
+            stripped = line.strip()
+
+            if pending_section is not None:
+                m = _ADDR_SIZE_RE.match(line)
+                if m:
+                    entries.append({
+                        "name": pending_section,
+                        "address": int(m.group(1), 16),
+                        "size": int(m.group(2), 16),
+                        "object": m.group(3),
+                    })
+                pending_section = None
+                continue
+
+            for prefix in RAM_SECTION_PREFIXES:
+                if not stripped.startswith(prefix):
+                    continue
+                parts = stripped.split()
+                name = parts[0][len(".time_critical."):] \
+                    if parts[0].startswith(".time_critical.") else parts[0]
+                if len(parts) >= 3 and parts[1].startswith("0x"):
+                    entries.append({
+                        "name": name,
+                        "address": int(parts[1], 16),
+                        "size": int(parts[2], 16),
+                        "object": parts[3] if len(parts) > 3 else "",
+                    })
+                else:
+                    # Section name alone — address/size on the next line
+                    pending_section = name
+                break
+
+    # Linker GC can leave zero-size stubs; they cost nothing
+    return [e for e in entries if e["size"] > 0]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Report SRAM spent on AI_HOT_FUNC / RAM-placed functions")
+    parser.add_argument("map_file", help="GNU ld .map file from the firmware link")
+    parser.add_argument("--json", action="store_true",
+                        help="Emit machine-readable JSON instead of a table")
+    args = parser.parse_args()
+
+    map_path = Path(args.map_file)
+    if not map_path.exists():
+        print(f"ERROR: {map_path} not found", file=sys.stderr)
+        return 1
+
+    entries = parse_map(map_path)
+    if not entries:
+        print("ERROR: no .time_critical.* / .ram_func sections found — "
+              "is this the right map file?", file=sys.stderr)
+        return 1
+
+    entries.sort(key=lambda e: e["size"], reverse=True)
+    total = sum(e["size"] for e in entries)
+
+    if args.json:
+        print(json.dumps({"total_bytes": total, "functions": entries}, indent=2))
+        return 0
+
+    name_width = max(len(e["name"]) for e in entries)
+    print(f"{'Function':<{name_width}}  {'Size':>6}  Object")
+    print(f"{'-' * name_width}  {'-' * 6}  {'-' * 30}")
+    for e in entries:
+        obj = Path(e["object"]).name if e["object"] else ""
+        print(f"{e['name']:<{name_width}}  {e['size']:>6}  {obj}")
+    print(f"{'-' * name_width}  {'-' * 6}")
+    print(f"{'TOTAL':<{name_width}}  {total:>6}  ({len(entries)} functions in SRAM)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
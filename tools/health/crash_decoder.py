@@ -42,16 +42,36 @@ DEFAULT_ADDR2LINE = "arm-none-eabi-addr2line"
 # Core Functions
 # =========================================================================
 
+def _to_int(value):
+    """Accept both hex strings and plain integers."""
+    return int(value, 16) if isinstance(value, str) else value
+
+
 def parse_crash_json(data):
-    """Parse crash JSON with hex string addresses."""
-    return {
-        "magic": int(data["magic"], 16) if isinstance(data["magic"], str) else data["magic"],
-        "pc": int(data["pc"], 16) if isinstance(data["pc"], str) else data["pc"],
-        "lr": int(data["lr"], 16) if isinstance(data["lr"], str) else data["lr"],
-        "xpsr": int(data["xpsr"], 16) if isinstance(data["xpsr"], str) else data["xpsr"],
+    """Parse crash JSON with hex string addresses.
+
+    Version 2 reports (flash crash ring) add optional fields:
+    regs (stacked R0-R3,R12,LR,PC,xPSR), backtrace (scanned return
+    address candidates), and recent_logs (hex-encoded log-ring tails
+    per core, decodable with tools/logging/log_decoder.py).
+    """
+    crash = {
+        "magic": _to_int(data["magic"]),
+        "pc": _to_int(data["pc"]),
+        "lr": _to_int(data["lr"]),
+        "xpsr": _to_int(data["xpsr"]),
         "core_id": data["core_id"],
         "task_number": data["task_number"],
     }
+    if "regs" in data:
+        crash["regs"] = [_to_int(r) for r in data["regs"]]
+    if "backtrace" in data:
+        crash["backtrace"] = [_to_int(a) for a in data["backtrace"]]
+    if "recent_logs" in data:
+        crash["recent_logs"] = data["recent_logs"]
+    if "tick" in data:
+        crash["tick"] = data["tick"]
+    return crash
 
 
 def resolve_address(addr, elf_path, addr2line_path):
@@ -95,6 +115,30 @@ def decode_crash(crash, elf_path, addr2line_path):
         "xpsr": f"0x{crash['xpsr']:08X}",
     }
 
+    if "tick" in crash:
+        result["tick"] = crash["tick"]
+
+    if "regs" in crash:
+        reg_names = ["R0", "R1", "R2", "R3", "R12", "LR", "PC", "xPSR"]
+        result["regs"] = {
+            name: f"0x{value:08X}"
+            for name, value in zip(reg_names, crash["regs"])
+        }
+
+    if "backtrace" in crash:
+        result["backtrace"] = [
+            {
+                "address": f"0x{addr:08X}",
+                **resolve_address(addr & ~1, elf_path, addr2line_path),
+            }
+            for addr in crash["backtrace"]
+        ]
+
+    if "recent_logs" in crash:
+        # Raw log-ring tails; pipe through log_decoder.py with the token
+        # database for human-readable messages.
+        result["recent_logs"] = crash["recent_logs"]
+
     # For HardFault and Stack Overflow, resolve PC/LR
     if magic in (0xDEADFA11, 0xDEAD57AC):
         pc_info = resolve_address(crash["pc"], elf_path, addr2line_path)
@@ -170,6 +214,31 @@ def format_text(decoded):
 
     lines.append("")
     lines.append(f" xPSR:     {decoded['xpsr']}")
+
+    if "regs" in decoded:
+        lines.append("")
+        lines.append(" Stacked registers:")
+        regs = decoded["regs"]
+        names = list(regs.keys())
+        for i in range(0, len(names), 4):
+            row = "   ".join(f"{n:<4} {regs[n]}" for n in names[i:i + 4])
+            lines.append(f"   {row}")
+
+    if "backtrace" in decoded:
+        lines.append("")
+        lines.append(" Backtrace (candidate return addresses):")
+        for i, frame in enumerate(decoded["backtrace"]):
+            lines.append(
+                f"   #{i:<2} {frame['address']} -> "
+                f"{frame['location']} ({frame['function']})"
+            )
+
+    if "recent_logs" in decoded:
+        lines.append("")
+        lines.append(" Recent logs captured (hex, feed to log_decoder.py):")
+        for core, hexdata in decoded["recent_logs"].items():
+            lines.append(f"   {core}: {len(hexdata) // 2} bytes")
+
     lines.append("=" * 55)
     lines.append("")
     return "\n".join(lines)
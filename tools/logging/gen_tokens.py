@@ -47,11 +47,12 @@ def fnv1a_hash(s: str) -> int:
 # Source Scanner
 # ===========================================================================
 
-# Regex to match LOG_ERROR/WARN/INFO/DEBUG with or without _S suffix
+# Regex to match LOG_ERROR/WARN/INFO/DEBUG with optional _S and/or
+# _FROM_ISR suffixes (ISR-safe variants share the same wire format)
 # Captures: level, optional _S, format string
 # Handles multi-line calls via re.DOTALL
 LOG_PATTERN = re.compile(
-    r'LOG_(ERROR|WARN|INFO|DEBUG)(_S)?\s*\(\s*"((?:[^"\\]|\\.)*)"',
+    r'LOG_(ERROR|WARN|INFO|DEBUG)(_S)?(?:_FROM_ISR)?\s*\(\s*"((?:[^"\\]|\\.)*)"',
     re.MULTILINE
 )
 
@@ -64,6 +65,50 @@ C_COMMENT_PATTERN = re.compile(
 # Parse printf-style format specifiers to extract arg types
 FORMAT_SPEC_PATTERN = re.compile(r'%[-+0 #]*\d*\.?\d*[hlLzjt]*([diouxXeEfFgGaAcspn%])')
 
+# Per-module log domain declaration in a source file:
+#   AI_LOG_MODULE(main);
+MODULE_DECL_PATTERN = re.compile(r'AI_LOG_MODULE\s*\(\s*(\w+)\s*\)')
+
+# Threshold registrations in ai_log_config.h:
+#   #define AI_LOG_MODULE_LEVEL_main    AI_LOG_LEVEL_DEBUG
+MODULE_LEVEL_PATTERN = re.compile(
+    r'#define\s+AI_LOG_MODULE_LEVEL_(\w+)\s+AI_LOG_LEVEL_(ERROR|WARN|INFO|DEBUG)'
+)
+
+# Global compile-time floor (only matched if defined to a named level):
+#   #define AI_LOG_LEVEL_MIN    AI_LOG_LEVEL_DEBUG
+GLOBAL_LEVEL_PATTERN = re.compile(
+    r'#define\s+AI_LOG_LEVEL_MIN\s+AI_LOG_LEVEL_(ERROR|WARN|INFO|DEBUG)'
+)
+
+# Numeric level ordering — must match ai_log_config.h
+LEVEL_ORDER = {'ERROR': 0, 'WARN': 1, 'INFO': 2, 'DEBUG': 3}
+
+
+def parse_config(config_path: str):
+    """Parse ai_log_config.h for the global floor and per-module thresholds.
+
+    Returns (global_min: int, module_levels: {name: int}). Sites above
+    either limit are compiled out by _AI_LOG_ENABLED() in ai_log.h, so
+    they must not appear in the token database either.
+    """
+    global_min = LEVEL_ORDER['DEBUG']
+    module_levels = {}
+    try:
+        with open(config_path, 'r', encoding='utf-8', errors='replace') as f:
+            source = strip_comments(f.read())
+    except (OSError, IOError) as e:
+        print(f"  WARNING: Cannot read {config_path}: {e} — "
+              f"assuming all sites enabled", file=sys.stderr)
+        return global_min, module_levels
+
+    m = GLOBAL_LEVEL_PATTERN.search(source)
+    if m:
+        global_min = LEVEL_ORDER[m.group(1)]
+    for m in MODULE_LEVEL_PATTERN.finditer(source):
+        module_levels[m.group(1)] = LEVEL_ORDER[m.group(2)]
+    return global_min, module_levels
+
 
 def strip_comments(source: str) -> str:
     """Remove C-style comments from source code."""
@@ -96,9 +141,16 @@ def parse_arg_types(fmt_string: str) -> str:
     return ''.join(types)
 
 
-def scan_file(filepath: str, base_dir: str) -> list:
+def scan_file(filepath: str, base_dir: str,
+              global_min: int, module_levels: dict,
+              skipped: list) -> list:
     """Scan a single source file for LOG_xxx() calls.
 
+    Sites compiled out by the per-module domain gate (level above the
+    file's AI_LOG_MODULE threshold or the global floor) are skipped —
+    they produce no code, so they get no token entry. `skipped` is a
+    single-element counter list updated in place.
+
     Returns list of dicts: {level, fmt, arg_types, file, line, has_args}
     """
     results = []
@@ -112,6 +164,21 @@ def scan_file(filepath: str, base_dir: str) -> list:
     # Strip comments to avoid matching log calls in comments
     clean_source = strip_comments(source)
 
+    # Per-module threshold: files without an AI_LOG_MODULE declaration
+    # (headers, not-yet-converted files) keep every site. An unregistered
+    # module name fails the C build anyway; treat it as fully enabled so
+    # the compiler error is the one the developer sees.
+    threshold = global_min
+    decl = MODULE_DECL_PATTERN.search(clean_source)
+    if decl:
+        module = decl.group(1)
+        threshold = min(global_min,
+                        module_levels.get(module, LEVEL_ORDER['DEBUG']))
+        if module not in module_levels:
+            print(f"  WARNING: {os.path.relpath(filepath, base_dir)}: "
+                  f"AI_LOG_MODULE({module}) has no AI_LOG_MODULE_LEVEL_"
+                  f"{module} entry in ai_log_config.h", file=sys.stderr)
+
     # We need line numbers, so scan the original source with offsets
     # But match against cleaned source
     for m in LOG_PATTERN.finditer(clean_source):
@@ -119,6 +186,10 @@ def scan_file(filepath: str, base_dir: str) -> list:
         is_simple = m.group(2) is not None  # _S suffix
         fmt_string = m.group(3)
 
+        if LEVEL_ORDER[level] > threshold:
+            skipped[0] += 1
+            continue
+
         # Compute line number from offset in cleaned source
         line_num = clean_source[:m.start()].count('\n') + 1
 
@@ -139,21 +210,25 @@ def scan_file(filepath: str, base_dir: str) -> list:
     return results
 
 
-def scan_directories(scan_dirs: list, base_dir: str) -> list:
+def scan_directories(scan_dirs: list, base_dir: str,
+                     global_min: int, module_levels: dict) -> list:
     """Recursively scan directories for .c and .h files."""
     all_tokens = []
     files_scanned = 0
+    skipped = [0]
 
     for scan_dir in scan_dirs:
         for root, _dirs, files in os.walk(scan_dir):
             for fname in sorted(files):
                 if fname.endswith(('.c', '.h')):
                     filepath = os.path.join(root, fname)
-                    tokens = scan_file(filepath, base_dir)
+                    tokens = scan_file(filepath, base_dir,
+                                       global_min, module_levels, skipped)
                     all_tokens.extend(tokens)
                     files_scanned += 1
 
-    print(f"  Scanned {files_scanned} files, found {len(all_tokens)} LOG_xxx calls")
+    print(f"  Scanned {files_scanned} files, found {len(all_tokens)} LOG_xxx calls"
+          f" ({skipped[0]} compiled out by level/module thresholds)")
     return all_tokens
 
 
@@ -292,12 +367,23 @@ def main():
         '--base-dir', default='.',
         help='Base directory for relative file paths (default: cwd)'
     )
+    parser.add_argument(
+        '--config',
+        default='firmware/components/logging/include/ai_log_config.h',
+        help='ai_log_config.h to read AI_LOG_LEVEL_MIN and '
+             'AI_LOG_MODULE_LEVEL_* thresholds from'
+    )
     args = parser.parse_args()
 
     print("gen_tokens.py: Scanning for LOG_xxx() calls...")
 
+    # 0. Read the compile-time filter config — sites the gate compiles
+    #    out must not appear in the token database
+    global_min, module_levels = parse_config(args.config)
+
     # 1. Scan source files
-    all_tokens = scan_directories(args.scan_dirs, args.base_dir)
+    all_tokens = scan_directories(args.scan_dirs, args.base_dir,
+                                  global_min, module_levels)
 
     # 2. Build unique token database (detect collisions)
     db = build_token_database(all_tokens)
@@ -7,9 +7,17 @@ from Channel 1, decodes them using the token_database.csv, and emits
 structured JSON lines.
 
 Packet wire format:
-    Byte 0-3:  Token ID (uint32, little-endian) — FNV-1a hash of format string
-    Byte 4:    [level:4 bits][arg_count:4 bits]
-    Byte 5+:   Arguments, sequentially:
+    Byte 0:    [core:1 bit (bit7)][seq:7 bits] — per-core wrapping sequence
+               (present when firmware builds with AI_LOG_USE_CORE_RINGS=1,
+               the default; disable with --no-seq-prefix for direct-mode
+               firmware builds)
+    Byte 1-4:  Token ID (uint32, little-endian) — FNV-1a hash of format string
+    Byte 5:    [ts flag:1 bit (bit7)][level:3 bits][arg_count:4 bits]
+    If bit7:   Varint delta timestamp — microseconds since the previous
+               packet on the SAME core (firmware AI_LOG_TIMESTAMPS=1).
+               The decoder accumulates these per core into ts_us, a
+               device-side clock immune to RTT buffering skew.
+    Then:      Arguments, sequentially:
                - int32/uint32: ZigZag varint (1-5 bytes)
                - float: Raw IEEE754 LE (4 bytes)
 
@@ -252,29 +260,113 @@ class RTTStreamReader:
         return len(self.buffer)
 
 
+class BytesStreamReader:
+    """Reader over an in-memory byte stream (flash region dumps)."""
+
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def read_bytes(self, n: int) -> bytes:
+        if self.pos + n > len(self.data):
+            raise ConnectionError("end of dump")
+        result = self.data[self.pos : self.pos + n]
+        self.pos += n
+        return result
+
+    def peek_available(self) -> int:
+        return len(self.data) - self.pos
+
+
+# ===========================================================================
+# Flash Persistence Ring (log_persist.c dump unwrapping)
+# ===========================================================================
+
+# Page format (firmware/components/logging/include/log_persist.h):
+# [magic:2 = 0x504C "LP"][used:2][seq:4] then `used` payload bytes,
+# 0xFF pad to the 256B flash page. Payloads concatenated in seq order
+# reproduce the exact RTT Channel 1 byte stream.
+PERSIST_PAGE_MAGIC = 0x504C
+PERSIST_PAGE_SIZE = 256
+PERSIST_PAGE_HDR = 8
+
+
+def unwrap_persist_region(image: bytes) -> bytes:
+    """Reassemble the log stream from a dumped flash persistence region.
+
+    Pages are ordered by their monotonic sequence number, which handles
+    the circular wrap; blank (erased) pages are skipped. After a wrap
+    the oldest surviving page usually starts mid-packet — the decoder
+    emits a garbled record or two before falling back in step.
+    """
+    pages = []
+    for off in range(0, len(image) - PERSIST_PAGE_SIZE + 1, PERSIST_PAGE_SIZE):
+        magic, used, seq = struct.unpack_from('<HHI', image, off)
+        if magic != PERSIST_PAGE_MAGIC or used > PERSIST_PAGE_SIZE - PERSIST_PAGE_HDR:
+            continue
+        pages.append((seq, image[off + PERSIST_PAGE_HDR:
+                                 off + PERSIST_PAGE_HDR + used]))
+    pages.sort(key=lambda p: p[0])
+    return b''.join(payload for _, payload in pages)
+
+
 # ===========================================================================
 # Main Decoder Loop
 # ===========================================================================
 
 def decode_stream(reader: RTTStreamReader, db: dict, expected_build_id: int,
-                  output_file=None, validate_build_id: bool = True):
+                  output_file=None, validate_build_id: bool = True,
+                  seq_prefix: bool = True):
     """Continuously decode packets from RTT stream and emit JSON."""
     packet_count = 0
     first_packet = True
 
+    # Per-core last-seen sequence number (7-bit, wrapping) for gap detection
+    last_seq = {0: None, 1: None}
+
+    # Per-core accumulated device time (µs) from packet delta timestamps.
+    # Without the seq prefix the core is unknown — key None accumulates all.
+    device_time = {0: 0, 1: 0, None: 0}
+
     out = output_file if output_file else sys.stdout
 
     while True:
         try:
+            # 0. Sequence prefix byte: [core:1][seq:7] (ring-mode firmware)
+            core_id = None
+            seq = None
+            seq_gap = 0
+            if seq_prefix:
+                prefix = reader.read_bytes(1)[0]
+                core_id = (prefix >> 7) & 0x01
+                seq = prefix & 0x7F
+                if last_seq[core_id] is not None:
+                    expected = (last_seq[core_id] + 1) & 0x7F
+                    seq_gap = (seq - expected) & 0x7F
+                last_seq[core_id] = seq
+
             # 1. Read token ID (4 bytes, LE)
             token_bytes = reader.read_bytes(4)
             token_id = struct.unpack('<I', token_bytes)[0]
 
-            # 2. Read level + arg count (1 byte)
+            # 2. Read meta byte: [ts flag:1][level:3][arg_count:4]
             meta_byte = reader.read_bytes(1)[0]
-            level = (meta_byte >> 4) & 0x0F
+            has_timestamp = bool(meta_byte & 0x80)
+            level = (meta_byte >> 4) & 0x07
             arg_count = meta_byte & 0x0F
 
+            # 2.5. Varint delta timestamp (µs since previous packet, per core)
+            delta_us = None
+            if has_timestamp:
+                varint_bytes = bytearray()
+                while True:
+                    b = reader.read_bytes(1)[0]
+                    varint_bytes.append(b)
+                    if (b & 0x80) == 0 or len(varint_bytes) >= 5:
+                        break
+                delta_us, _ = decode_varint(bytes(varint_bytes), 0)
+                device_time[core_id] = (device_time[core_id] + delta_us) & 0xFFFFFFFF
+
             # 3. Look up token in database
             entry = db.get(token_id)
 
@@ -325,6 +417,14 @@ def decode_stream(reader: RTTStreamReader, db: dict, expected_build_id: int,
                     'line': entry['line'],
                     'raw_args': args,
                 }
+                if seq_prefix:
+                    record['core'] = core_id
+                    record['seq'] = seq
+                    if seq_gap:
+                        record['seq_gap'] = seq_gap  # Packets lost/reordered
+                if has_timestamp:
+                    record['ts_us'] = device_time[core_id]
+                    record['delta_us'] = delta_us
             else:
                 # Unknown token
                 record = {
@@ -334,6 +434,9 @@ def decode_stream(reader: RTTStreamReader, db: dict, expected_build_id: int,
                     'token': f'0x{token_id:08x}',
                     'raw_args': [],
                 }
+                if has_timestamp:
+                    record['ts_us'] = device_time[core_id]
+                    record['delta_us'] = delta_us
 
                 # Try to skip arg_count args (best effort)
                 for _ in range(arg_count):
@@ -426,6 +529,10 @@ Examples:
 
     # Custom host:
     python3 tools/logging/log_decoder.py --host 192.168.1.100 --port 9091 --csv tools/logging/token_database.csv
+
+    # Decode a dumped flash persistence region (AI_LOG_FLASH_PERSIST,
+    # e.g. `picotool save -r 0x101D9000 0x101DD000 logring.bin`):
+    python3 tools/logging/log_decoder.py --file logring.bin --csv tools/logging/token_database.csv
 """
     )
     parser.add_argument(
@@ -440,6 +547,11 @@ Examples:
         '--csv', required=True,
         help='Path to token_database.csv'
     )
+    parser.add_argument(
+        '--file', default=None,
+        help='Decode a dumped flash log-persistence region instead of '
+             'connecting to RTT (AI_LOG_FLASH_PERSIST builds)'
+    )
     parser.add_argument(
         '--output', default=None,
         help='Output JSONL file (default: stdout)'
@@ -448,6 +560,11 @@ Examples:
         '--no-validate-build-id', action='store_true',
         help='Skip BUILD_ID validation on first packet'
     )
+    parser.add_argument(
+        '--no-seq-prefix', action='store_true',
+        help='Firmware built with AI_LOG_USE_CORE_RINGS=0 (no [core|seq] '
+             'prefix byte on packets)'
+    )
     parser.add_argument(
         '--max-retries', type=int, default=10,
         help='Max connection retry attempts (default: 10)'
@@ -460,9 +577,17 @@ Examples:
     print(f"Loaded {len(db)} tokens, BUILD_ID=0x{build_id:08x}" if build_id
           else f"Loaded {len(db)} tokens, no BUILD_ID", file=sys.stderr)
 
-    # Connect to RTT TCP server
-    sock = connect_with_retry(args.host, args.port, args.max_retries)
-    reader = RTTStreamReader(sock)
+    # Input: flash region dump or live RTT TCP stream
+    sock = None
+    if args.file:
+        image = Path(args.file).read_bytes()
+        stream = unwrap_persist_region(image)
+        print(f"Unwrapped {len(stream)} stream bytes from {args.file} "
+              f"({len(image)} byte region)", file=sys.stderr)
+        reader = BytesStreamReader(stream)
+    else:
+        sock = connect_with_retry(args.host, args.port, args.max_retries)
+        reader = RTTStreamReader(sock)
 
     # Open output file if specified
     output_file = None
@@ -475,9 +600,11 @@ Examples:
             reader, db, build_id,
             output_file=output_file,
             validate_build_id=not args.no_validate_build_id,
+            seq_prefix=not args.no_seq_prefix,
         )
     finally:
-        sock.close()
+        if sock:
+            sock.close()
         if output_file:
             output_file.close()
 
@@ -1,85 +1,140 @@
 #!/usr/bin/env python3
 """
-BB4: Config Sync — Stub for future GDB-based hot configuration swap.
+BB4: Config Sync — live configuration over the RTT command channel.
 
-This script will enable the AI agent to modify application parameters
-on the RP2040 without a full recompile/reflash cycle, by writing JSON
-configuration directly to the LittleFS partition via GDB memory commands.
+Sends framed commands to the firmware's RTT down-buffer (channel 2,
+cmd_channel.c) through OpenOCD's RTT TCP server. The device applies
+them within one poll period (~50ms): persisted fields go through
+fs_manager_update_config() (the background committer coalesces the
+flash write), and live consumers (runtime log level, supervisor
+interval) are pushed immediately. A tuning iteration that used to cost
+a reboot + LittleFS remount is now one TCP write.
 
-STATUS: STUB — Implementation deferred to BB4 Phase 2.
+Wire format (little-endian, one frame per command):
 
-Current Workaround:
-    The AI agent can modify configuration by:
-    1. Editing the config JSON in the firmware source
-    2. Reflashing via the HIL pipeline (~20s cycle)
+    [magic:1 = 0xC3][cmd:1][len:1][payload:len][chk:1]
 
-Future Implementation Plan:
-    1. Connect to OpenOCD GDB server (localhost:3333)
-    2. Halt the target
-    3. Write new config JSON to a RAM staging buffer
-    4. Set a "config_pending" flag in a known RAM address
-    5. Resume the target
-    6. Firmware detects the flag, reads RAM buffer, writes to LittleFS
-    7. Firmware clears the flag and applies new config
+    chk = XOR of cmd, len, and every payload byte.
 
-    Alternative approach (simpler):
-    1. Connect to OpenOCD GDB server
-    2. Call fs_manager_update_config() via GDB function call injection
-    3. Resume — no RAM buffer needed, but requires FreeRTOS to be running
+Commands:
+    0x01 SET_CONFIG    [blink_ms:4][log_level:1][interval_ms:4]
+                       (0 / 0xFF / 0 = leave field unchanged; persisted)
+    0x02 SET_INTERVAL  [interval_ms:4]  (live only, not persisted)
+    0x03 FLUSH_CONFIG  (force pending config update onto flash)
+    0x04 GET_DIAG      (full vitals snapshot on next supervisor cycle)
 
-    Both approaches require:
-    - Known symbol addresses from firmware.elf (via arm-none-eabi-nm)
-    - GDB MI protocol client (Python gdb module or pygdbmi)
+Usage:
+    # Persisted update: blink at 250ms, keep other fields
+    python3 config_sync.py --blink 250
 
-Usage (future):
-    python config_sync.py --host localhost --gdb-port 3333 \\
-        --config '{"blink_delay_ms": 250, "log_level": 3}'
+    # Sweep the supervisor rate without flash wear, then restore
+    python3 config_sync.py --interval-live 100
+    python3 config_sync.py --interval-live 0
 
-Dependencies (future):
-    - pygdbmi (GDB Machine Interface client)
-    - arm-none-eabi-gdb (from Pico SDK toolchain)
+    # Durability before a deliberate reboot
+    python3 config_sync.py --flush
+
+    # One-shot diagnostics (snapshot arrives on the telemetry stream)
+    python3 config_sync.py --diag
+
+Requires a running OpenOCD with an RTT server on the channel-2 port
+(default 9092) — the same port telemetry_manager.py reads.
 
 See Also:
-    - firmware/components/persistence/include/fs_manager.h — Config API
-    - resources/004-Data-Persistence-Telemetry/ — Architecture spec
-    - resources/Host-Side-Python-Tools.md — Tool contracts
+    - firmware/components/command/include/cmd_channel.h — wire format
+    - firmware/components/persistence/include/fs_manager.h — config API
 """
 
 import argparse
-import json
+import socket
+import struct
 import sys
 
+FRAME_MAGIC = 0xC3
+
+CMD_SET_CONFIG = 0x01
+CMD_SET_INTERVAL = 0x02
+CMD_FLUSH_CONFIG = 0x03
+CMD_GET_DIAG = 0x04
+
+# No-change sentinels — must match fs_manager_update_config()
+NO_CHANGE_BLINK = 0
+NO_CHANGE_LEVEL = 0xFF
+NO_CHANGE_INTERVAL = 0
+
+
+def build_frame(cmd: int, payload: bytes = b"") -> bytes:
+    """Frame one command: magic, cmd, len, payload, XOR checksum."""
+    chk = cmd ^ len(payload)
+    for b in payload:
+        chk ^= b
+    return bytes([FRAME_MAGIC, cmd, len(payload)]) + payload + bytes([chk])
+
 
 def main():
     parser = argparse.ArgumentParser(
-        description="BB4 Config Sync — Hot config swap (STUB)"
-    )
-    parser.add_argument(
-        "--host", default="localhost", help="GDB server host"
-    )
-    parser.add_argument(
-        "--gdb-port", type=int, default=3333, help="GDB server port"
-    )
-    parser.add_argument(
-        "--config", type=str, help="JSON config string to write"
-    )
-    parser.add_argument(
-        "--elf", type=str, help="Path to firmware.elf for symbol resolution"
+        description="BB4 Config Sync — live config over the RTT command channel"
     )
+    parser.add_argument("--host", default="localhost",
+                        help="OpenOCD RTT server host (default: localhost)")
+    parser.add_argument("--port", type=int, default=9092,
+                        help="RTT channel 2 TCP port (default: 9092)")
+    parser.add_argument("--blink", type=int,
+                        help="New blink_delay_ms (persisted)")
+    parser.add_argument("--log-level", type=int, choices=range(4),
+                        help="New runtime log level 0=ERR..3=DBG (persisted)")
+    parser.add_argument("--interval", type=int,
+                        help="New telemetry_interval_ms (persisted)")
+    parser.add_argument("--interval-live", type=int,
+                        help="Supervisor interval in ms, live only — not "
+                             "persisted (0 = restore default)")
+    parser.add_argument("--flush", action="store_true",
+                        help="Force any pending config update onto flash")
+    parser.add_argument("--diag", action="store_true",
+                        help="Request a one-shot full vitals snapshot")
     args = parser.parse_args()
 
-    print(json.dumps({
-        "status": "stub",
-        "component": "config_sync",
-        "message": (
-            "Config sync is a documented stub. "
-            "Hot config swap via GDB will be implemented in BB4 Phase 2. "
-            "Current workaround: modify config in source and reflash."
-        ),
-        "planned_approach": "GDB function call injection to fs_manager_update_config()",
-        "dependencies": ["pygdbmi", "arm-none-eabi-gdb"],
-    }))
-
+    frames = []
+
+    if args.blink is not None or args.log_level is not None \
+            or args.interval is not None:
+        blink = args.blink if args.blink is not None else NO_CHANGE_BLINK
+        level = args.log_level if args.log_level is not None else NO_CHANGE_LEVEL
+        interval = args.interval if args.interval is not None \
+            else NO_CHANGE_INTERVAL
+        payload = struct.pack("<IBI", blink, level, interval)
+        frames.append(("SET_CONFIG", build_frame(CMD_SET_CONFIG, payload)))
+        print(f"SET_CONFIG: blink={blink} level={level} interval={interval}")
+
+    if args.interval_live is not None:
+        payload = struct.pack("<I", args.interval_live)
+        frames.append(("SET_INTERVAL", build_frame(CMD_SET_INTERVAL, payload)))
+        print(f"SET_INTERVAL: {args.interval_live}ms (live only)")
+
+    if args.flush:
+        frames.append(("FLUSH_CONFIG", build_frame(CMD_FLUSH_CONFIG)))
+        print("FLUSH_CONFIG")
+
+    if args.diag:
+        frames.append(("GET_DIAG", build_frame(CMD_GET_DIAG)))
+        print("GET_DIAG (snapshot arrives on the telemetry stream)")
+
+    if not frames:
+        parser.error("nothing to do — pass at least one command option")
+
+    try:
+        with socket.create_connection((args.host, args.port), timeout=5) as sock:
+            for name, frame in frames:
+                sock.sendall(frame)
+                print(f"  sent {name}: {frame.hex()}")
+    except OSError as e:
+        print(f"ERROR: cannot reach RTT server at "
+              f"{args.host}:{args.port}: {e}", file=sys.stderr)
+        print("Is OpenOCD running with an RTT server on the channel-2 port?",
+              file=sys.stderr)
+        return 1
+
+    print(f"Done — {len(frames)} command(s) delivered.")
     return 0
 
 
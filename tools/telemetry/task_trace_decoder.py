@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""
+Context-switch trace decoder — RTT Channel 3 timeline reconstruction.
+
+Connects to OpenOCD's RTT Channel 3 (TCP 9093) and decodes the binary
+switch-event stream produced by firmware/components/instrumentation/
+src/task_trace.c, reconstructing a per-core scheduling timeline.
+
+Wire format (one block per flusher drain per core):
+    [0xC0|core:1][seq:1][payload_len:2 LE][last_ts:4 LE][events...]
+
+Each event: [dir:1 bit (bit7)][task_number:7 bits] then a varint
+microsecond delta since the previous event on the same core. last_ts
+is the absolute TIMERAWL timestamp of the LAST event in the block —
+the decoder anchors the delta chain to it, so a dropped block (seq
+gap) costs only that block's events.
+
+Output: one JSON object per event on stdout —
+    {"core": 0, "ts_us": ..., "event": "in"|"out", "task": N}
+plus periodic per-task occupancy summaries with --summary-interval.
+
+Usage:
+    python task_trace_decoder.py [--host HOST] [--port PORT] [--raw FILE]
+
+Dependencies: Python 3.8+ stdlib only.
+"""
+
+import argparse
+import json
+import socket
+import struct
+import sys
+import time
+
+BLOCK_HEADER_SIZE = 8
+BLOCK_MAGIC_MASK = 0xFE      # 0xC0 | core(1 bit)
+BLOCK_MAGIC = 0xC0
+
+
+def decode_varint(data: bytes, pos: int) -> tuple[int, int] | None:
+    """Decode one LEB128-style varint. Returns (value, new_pos) or None
+    if the buffer ends mid-varint."""
+    value = 0
+    shift = 0
+    while pos < len(data):
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not (b & 0x80):
+            return value, pos
+        shift += 7
+    return None
+
+
+def decode_block(payload: bytes, last_ts: int) -> list[dict]:
+    """Decode one block's events, anchoring times so the final event
+    lands exactly on last_ts (the firmware-supplied absolute anchor)."""
+    raw = []          # (dir_in, task, delta)
+    pos = 0
+    while pos < len(payload):
+        hdr = payload[pos]
+        pos += 1
+        decoded = decode_varint(payload, pos)
+        if decoded is None:
+            break     # Truncated event — should not happen (whole-event blocks)
+        delta, pos = decoded
+        raw.append(((hdr >> 7) & 1, hdr & 0x7F, delta))
+
+    # Chain deltas forward from 0, then shift so the last event == last_ts
+    events = []
+    t = 0
+    for dir_in, task, delta in raw:
+        t += delta
+        events.append([dir_in, task, t])
+    offset = (last_ts - t) & 0xFFFFFFFF
+    for ev in events:
+        ev[2] = (ev[2] + offset) & 0xFFFFFFFF
+
+    return [
+        {"event": "in" if dir_in else "out", "task": task, "ts_us": ts}
+        for dir_in, task, ts in events
+    ]
+
+
+def extract_blocks(buffer: bytes) -> tuple[list[tuple[int, int, int, bytes]], bytes]:
+    """Frame complete blocks out of the raw byte stream.
+
+    Returns ([(core, seq, last_ts, payload), ...], remaining_buffer).
+    """
+    blocks = []
+    offset = 0
+
+    while offset + BLOCK_HEADER_SIZE <= len(buffer):
+        hdr = buffer[offset]
+        if (hdr & BLOCK_MAGIC_MASK) != BLOCK_MAGIC:
+            offset += 1   # Out of sync — hunt for the next block marker
+            continue
+        core = hdr & 0x01
+        seq = buffer[offset + 1]
+        (payload_len,) = struct.unpack_from("<H", buffer, offset + 2)
+        (last_ts,) = struct.unpack_from("<I", buffer, offset + 4)
+
+        end = offset + BLOCK_HEADER_SIZE + payload_len
+        if end > len(buffer):
+            break         # Incomplete block — wait for more data
+        blocks.append((core, seq, last_ts,
+                       buffer[offset + BLOCK_HEADER_SIZE : end]))
+        offset = end
+
+    return blocks, buffer[offset:]
+
+
+class TimelineReconstructor:
+    """Per-core event stream merge + run-slice accounting."""
+
+    def __init__(self):
+        self.expected_seq = [None, None]
+        self.running = [None, None]       # (task, switched_in_ts) per core
+        self.occupancy: dict[tuple[int, int], int] = {}  # (core, task) → us
+        self.gap_count = 0
+
+    def feed(self, core: int, seq: int, last_ts: int, payload: bytes) -> list[dict]:
+        out = []
+
+        if self.expected_seq[core] is not None and seq != self.expected_seq[core]:
+            missed = (seq - self.expected_seq[core]) & 0xFF
+            self.gap_count += missed
+            self.running[core] = None     # Timeline broken — close open slice
+            out.append({"type": "gap", "core": core, "missed_blocks": missed})
+        self.expected_seq[core] = (seq + 1) & 0xFF
+
+        for ev in decode_block(payload, last_ts):
+            ev["type"] = "switch"
+            ev["core"] = core
+            out.append(ev)
+
+            if ev["event"] == "in":
+                self.running[core] = (ev["task"], ev["ts_us"])
+            elif self.running[core] is not None:
+                task, t_in = self.running[core]
+                if task == ev["task"]:
+                    run_us = (ev["ts_us"] - t_in) & 0xFFFFFFFF
+                    key = (core, task)
+                    self.occupancy[key] = self.occupancy.get(key, 0) + run_us
+                self.running[core] = None
+
+        return out
+
+    def summary(self) -> dict:
+        occ = [
+            {"core": core, "task": task, "run_us": us}
+            for (core, task), us in sorted(self.occupancy.items())
+        ]
+        result = {"type": "summary", "occupancy": occ,
+                  "gap_blocks": self.gap_count}
+        self.occupancy = {}
+        return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Context-switch trace decoder — RTT Channel 3"
+    )
+    parser.add_argument("--host", default="localhost",
+                        help="OpenOCD RTT TCP host (default: localhost)")
+    parser.add_argument("--port", type=int, default=9093,
+                        help="RTT Channel 3 TCP port (default: 9093)")
+    parser.add_argument("--raw", help="Decode a captured raw dump instead of TCP")
+    parser.add_argument("--summary-interval", type=float, default=5.0,
+                        help="Seconds between occupancy summaries (default: 5)")
+    parser.add_argument("--quiet", action="store_true",
+                        help="Emit only summaries, not individual switch events")
+    args = parser.parse_args()
+
+    recon = TimelineReconstructor()
+
+    def emit(events):
+        for ev in events:
+            if args.quiet and ev.get("type") == "switch":
+                continue
+            print(json.dumps(ev))
+        sys.stdout.flush()
+
+    if args.raw:
+        with open(args.raw, "rb") as f:
+            blocks, rest = extract_blocks(f.read())
+        for core, seq, last_ts, payload in blocks:
+            emit(recon.feed(core, seq, last_ts, payload))
+        if rest:
+            print(f"[task_trace_decoder] {len(rest)}B trailing", file=sys.stderr)
+        print(json.dumps(recon.summary()))
+        return
+
+    print(f"[task_trace_decoder] Connecting to {args.host}:{args.port}...",
+          file=sys.stderr)
+    sock = socket.create_connection((args.host, args.port), timeout=5.0)
+    sock.settimeout(2.0)
+    print("[task_trace_decoder] Connected to RTT Channel 3", file=sys.stderr)
+
+    buffer = b""
+    last_summary = time.monotonic()
+
+    try:
+        while True:
+            try:
+                data = sock.recv(4096)
+            except socket.timeout:
+                data = b""
+            if data:
+                buffer += data
+                blocks, buffer = extract_blocks(buffer)
+                for core, seq, last_ts, payload in blocks:
+                    emit(recon.feed(core, seq, last_ts, payload))
+
+            now = time.monotonic()
+            if now - last_summary >= args.summary_interval:
+                print(json.dumps(recon.summary()))
+                sys.stdout.flush()
+                last_summary = now
+    except KeyboardInterrupt:
+        print(json.dumps(recon.summary()))
+        print("\n[task_trace_decoder] Stopped.", file=sys.stderr)
+    finally:
+        sock.close()
+
+
+if __name__ == "__main__":
+    main()
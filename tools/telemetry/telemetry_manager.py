@@ -35,14 +35,61 @@ from pathlib import Path
 # Packet type constants
 PKT_SYSTEM_VITALS = 0x01
 PKT_TASK_STATS = 0x02
-
-# System vitals header: [type:1][timestamp:4][free_heap:4][min_free_heap:4][task_count:1]
-HEADER_FORMAT = "<BIIIB"
-HEADER_SIZE = struct.calcsize(HEADER_FORMAT)  # 14 bytes
-
-# Per-task entry: [task_number:1][state:1][priority:1][stack_hwm:2][cpu_pct:1][runtime:2]
-TASK_ENTRY_FORMAT = "<BBBHBH"
-TASK_ENTRY_SIZE = struct.calcsize(TASK_ENTRY_FORMAT)  # 8 bytes
+PKT_TRACE_STATS = 0x03
+PKT_BOOT_TIMELINE = 0x04
+PKT_CORE_LOAD = 0x05
+PKT_BATCH = 0xB5
+
+# Batch frame: [type:1][entry_count:1][payload_len:2 LE] then per entry
+# [orig_len:2 LE][enc_len:2 LE][slot:4|method:4][enc bytes]
+BATCH_FRAME_HEADER = 4
+BATCH_ENTRY_HEADER = 5
+BATCH_RAW = 0
+BATCH_RLE0 = 1
+BATCH_XOR_RLE0 = 2
+
+# Trace stats: [type:1][core:1][entry_count:1] then 17B per entry
+TRACE_ENTRY_SIZE = 17
+
+# Boot timeline: [type:1][count:1][dropped:1] then [name:8][timestamp_us:4]
+BOOT_ENTRY_SIZE = 12
+
+# Core load: [type:1][window_us:4][flash_ops:4][flash_busy_us:4][core_count:1]
+# then per core [idle_pct:1][switches:4][irq_time_us:4][irq_count:4]
+CORE_LOAD_HEADER_SIZE = 14
+CORE_LOAD_ENTRY_SIZE = 13
+
+# System vitals header:
+# [type:1][timestamp:4][free_heap:4][min_free_heap:4][largest_free_block:4]
+# [log_bytes:4][log_dropped:4][telem_bytes:4][telem_dropped:4][sleep_us:4]
+# [task_count:1]
+HEADER_FORMAT = "<BIIIIIIIIIB"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)  # 38 bytes
+
+# Per-task entry: [task_number:1][state:1][priority:1][stack_hwm:2][cpu_pct:1]
+# [runtime:2][lat_max_us:2][lat_mean_us:2][preempt_count:2]
+TASK_ENTRY_FORMAT = "<BBBHBHHHH"
+TASK_ENTRY_SIZE = struct.calcsize(TASK_ENTRY_FORMAT)  # 14 bytes
+
+# Delta entry change-mask bits (PKT_TASK_STATS) — field order matches
+# task_entry_t; sizes: state 1B, priority 1B, stack_hwm 2B, cpu 1B,
+# runtime 2B, latency 4B (max + mean), preempt 2B
+DELTA_STATE = 1 << 0
+DELTA_PRIORITY = 1 << 1
+DELTA_STACK_HWM = 1 << 2
+DELTA_CPU_PCT = 1 << 3
+DELTA_RUNTIME = 1 << 4
+DELTA_LATENCY = 1 << 5
+DELTA_PREEMPT = 1 << 6
+DELTA_FIELD_SIZES = [
+    (DELTA_STATE, 1),
+    (DELTA_PRIORITY, 1),
+    (DELTA_STACK_HWM, 2),
+    (DELTA_CPU_PCT, 1),
+    (DELTA_RUNTIME, 2),
+    (DELTA_LATENCY, 4),
+    (DELTA_PREEMPT, 2),
+]
 
 # Task state names (FreeRTOS eTaskState enum)
 TASK_STATES = {
@@ -63,6 +110,84 @@ ALERT_STACK_HWM_LOW = 32    # Words — stack nearly exhausted
 SUMMARY_INTERVAL_S = 300    # 5 minutes between summary reports
 
 
+# ===========================================================================
+# Batch Decompression
+# ===========================================================================
+
+def rle0_decode(data: bytes) -> bytes:
+    """Inverse of the firmware's _rle0_encode: nonzero bytes are
+    literals, [0x00][run_len] expands to run_len zero bytes."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        b = data[i]
+        i += 1
+        if b == 0:
+            out.extend(b"\x00" * data[i])
+            i += 1
+        else:
+            out.append(b)
+    return bytes(out)
+
+
+class BatchDecoder:
+    """Unpacks PKT_BATCH frames into the original telemetry packets.
+
+    Mirrors the firmware's two XOR reference slots (0 = vitals,
+    1 = task stats): every decoded vitals/task-stats packet becomes the
+    next reference for its slot, exactly as telemetry_driver.c keeps
+    s_prev_pkt. A dropped batch desynchronizes the references — the
+    firmware then ships RLE0/raw (length mismatch is impossible to hit
+    reliably), and a full snapshot resynchronizes us.
+    """
+
+    def __init__(self):
+        self.prev: list[bytes | None] = [None, None]
+
+    def decode(self, frame: bytes) -> list[bytes]:
+        count = frame[1]
+        packets = []
+        pos = BATCH_FRAME_HEADER
+
+        for _ in range(count):
+            if pos + BATCH_ENTRY_HEADER > len(frame):
+                break  # Truncated frame (RTT skip) — keep what we have
+            (orig_len,) = struct.unpack_from("<H", frame, pos)
+            (enc_len,) = struct.unpack_from("<H", frame, pos + 2)
+            slot = frame[pos + 4] >> 4
+            method = frame[pos + 4] & 0x0F
+            pos += BATCH_ENTRY_HEADER
+            enc = frame[pos : pos + enc_len]
+            pos += enc_len
+
+            if method == BATCH_RAW:
+                raw = enc
+            elif method == BATCH_RLE0:
+                raw = rle0_decode(enc)
+            elif method == BATCH_XOR_RLE0:
+                ref = self.prev[slot]
+                if ref is None or len(ref) != orig_len:
+                    continue  # Lost the reference — skip to resync
+                delta = rle0_decode(enc)
+                raw = bytes(a ^ b for a, b in zip(delta, ref))
+            else:
+                continue
+
+            if len(raw) != orig_len:
+                continue  # Corrupt entry
+
+            # Mirror the firmware: packets over its 512B tracking limit
+            # never become XOR references
+            if len(raw) <= 512:
+                if raw[0] == PKT_SYSTEM_VITALS:
+                    self.prev[0] = raw
+                elif raw[0] == PKT_TASK_STATS:
+                    self.prev[1] = raw
+            packets.append(raw)
+
+        return packets
+
+
 # ===========================================================================
 # Packet Decoder
 # ===========================================================================
@@ -75,9 +200,9 @@ def decode_vitals_packet(data: bytes) -> dict | None:
     if len(data) < HEADER_SIZE:
         return None
 
-    pkt_type, timestamp, free_heap, min_free_heap, task_count = struct.unpack_from(
-        HEADER_FORMAT, data, 0
-    )
+    (pkt_type, timestamp, free_heap, min_free_heap, largest_free_block,
+     log_bytes, log_dropped, telem_bytes, telem_dropped, sleep_us,
+     task_count) = struct.unpack_from(HEADER_FORMAT, data, 0)
 
     if pkt_type != PKT_SYSTEM_VITALS:
         return None  # Not a system vitals packet
@@ -89,7 +214,8 @@ def decode_vitals_packet(data: bytes) -> dict | None:
     tasks = []
     offset = HEADER_SIZE
     for _ in range(task_count):
-        task_num, state, priority, stack_hwm, cpu_pct, runtime = struct.unpack_from(
+        (task_num, state, priority, stack_hwm, cpu_pct, runtime,
+         lat_max, lat_mean, preempts) = struct.unpack_from(
             TASK_ENTRY_FORMAT, data, offset
         )
         tasks.append({
@@ -99,6 +225,9 @@ def decode_vitals_packet(data: bytes) -> dict | None:
             "stack_hwm_words": stack_hwm,
             "cpu_pct": cpu_pct,
             "runtime_ms": runtime,
+            "lat_max_us": lat_max,
+            "lat_mean_us": lat_mean,
+            "preemptions": preempts,
         })
         offset += TASK_ENTRY_SIZE
 
@@ -107,11 +236,123 @@ def decode_vitals_packet(data: bytes) -> dict | None:
         "timestamp_ticks": timestamp,
         "free_heap": free_heap,
         "min_free_heap": min_free_heap,
+        "largest_free_block": largest_free_block,
+        "log_bytes": log_bytes,
+        "log_dropped": log_dropped,
+        "telem_bytes": telem_bytes,
+        "telem_dropped": telem_dropped,
+        "sleep_us": sleep_us,
         "task_count": task_count,
         "tasks": tasks,
     }
 
 
+def delta_packet_size(data: bytes, offset: int) -> int | None:
+    """Compute the total size of a PKT_TASK_STATS delta packet.
+
+    Delta packets are variable-length — each entry is
+    [task_number:1][change_mask:1][changed fields], so we must walk the
+    masks. Returns None if the buffer doesn't yet hold the whole packet.
+    """
+    if offset + HEADER_SIZE > len(data):
+        return None
+    entry_count = struct.unpack_from(HEADER_FORMAT, data, offset)[-1]
+
+    pos = offset + HEADER_SIZE
+    for _ in range(entry_count):
+        if pos + 2 > len(data):
+            return None
+        mask = data[pos + 1]
+        pos += 2
+        for bit, size in DELTA_FIELD_SIZES:
+            if mask & bit:
+                pos += size
+        if pos > len(data):
+            return None
+    return pos - offset
+
+
+def decode_delta_packet(data: bytes, task_cache: dict) -> dict | None:
+    """Decode a PKT_TASK_STATS delta packet, merging into task_cache.
+
+    task_cache maps task_number → raw field dict and carries state
+    forward between packets (reset on every full snapshot by the caller).
+    Returns a synthesized vitals dict with the merged task list so the
+    analytics pipeline is agnostic to snapshot vs. delta.
+    """
+    (pkt_type, timestamp, free_heap, min_free_heap, largest_free_block,
+     log_bytes, log_dropped, telem_bytes, telem_dropped, sleep_us,
+     entry_count) = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if pkt_type != PKT_TASK_STATS:
+        return None
+
+    pos = HEADER_SIZE
+    for _ in range(entry_count):
+        task_num = data[pos]
+        mask = data[pos + 1]
+        pos += 2
+
+        entry = task_cache.setdefault(task_num, {
+            "state": 0, "priority": 0, "stack_hwm": 0,
+            "cpu_pct": 0, "runtime": 0,
+            "lat_max": 0, "lat_mean": 0, "preempts": 0,
+        })
+        if mask & DELTA_STATE:
+            entry["state"] = data[pos]
+            pos += 1
+        if mask & DELTA_PRIORITY:
+            entry["priority"] = data[pos]
+            pos += 1
+        if mask & DELTA_STACK_HWM:
+            entry["stack_hwm"] = struct.unpack_from("<H", data, pos)[0]
+            pos += 2
+        if mask & DELTA_CPU_PCT:
+            entry["cpu_pct"] = data[pos]
+            pos += 1
+        if mask & DELTA_RUNTIME:
+            entry["runtime"] = struct.unpack_from("<H", data, pos)[0]
+            pos += 2
+        if mask & DELTA_LATENCY:
+            entry["lat_max"], entry["lat_mean"] = struct.unpack_from(
+                "<HH", data, pos
+            )
+            pos += 4
+        if mask & DELTA_PREEMPT:
+            entry["preempts"] = struct.unpack_from("<H", data, pos)[0]
+            pos += 2
+
+    tasks = [
+        {
+            "task_number": num,
+            "state": TASK_STATES.get(e["state"], f"Unknown({e['state']})"),
+            "priority": e["priority"],
+            "stack_hwm_words": e["stack_hwm"],
+            "cpu_pct": e["cpu_pct"],
+            "runtime_ms": e["runtime"],
+            "lat_max_us": e["lat_max"],
+            "lat_mean_us": e["lat_mean"],
+            "preemptions": e["preempts"],
+        }
+        for num, e in sorted(task_cache.items())
+    ]
+
+    return {
+        "type": "system_vitals",
+        "timestamp_ticks": timestamp,
+        "free_heap": free_heap,
+        "min_free_heap": min_free_heap,
+        "largest_free_block": largest_free_block,
+        "log_bytes": log_bytes,
+        "log_dropped": log_dropped,
+        "telem_bytes": telem_bytes,
+        "telem_dropped": telem_dropped,
+        "sleep_us": sleep_us,
+        "task_count": len(tasks),
+        "tasks": tasks,
+        "delta": True,
+    }
+
+
 # ===========================================================================
 # Analytics Engine
 # ===========================================================================
@@ -289,6 +530,63 @@ def read_packets(sock: socket.socket) -> bytes:
         raise
 
 
+def decode_boot_timeline(data: bytes) -> list[dict]:
+    """Decode a PKT_BOOT_TIMELINE packet into an ordered phase list.
+
+    Each entry carries the phase name and the absolute TIMERAWL
+    timestamp at the END of that phase; duration_us is the delta from
+    the previous entry (the first entry measures from timer start).
+    """
+    count = data[1]
+    entries = []
+    prev_ts = 0
+    pos = 3
+    for _ in range(count):
+        name = data[pos : pos + 8].decode("ascii", errors="replace").strip()
+        (ts,) = struct.unpack_from("<I", data, pos + 8)
+        entries.append({
+            "phase": name,
+            "end_us": ts,
+            "duration_us": (ts - prev_ts) & 0xFFFFFFFF,
+        })
+        prev_ts = ts
+        pos += BOOT_ENTRY_SIZE
+    return entries
+
+
+def decode_core_load_packet(data: bytes) -> dict:
+    """Decode a PKT_CORE_LOAD packet into a per-core load breakdown.
+
+    All fields are deltas over window_us. idle_pct is 100 when the core
+    ran nothing but the idle task; flash_ops/flash_busy_us count the
+    flash_safe_op() windows where BOTH cores were frozen.
+    """
+    window_us, flash_ops, flash_busy_us = struct.unpack_from("<III", data, 1)
+    core_count = data[13]
+    cores = []
+    pos = CORE_LOAD_HEADER_SIZE
+    for core in range(core_count):
+        idle_pct = data[pos]
+        switches, irq_time_us, irq_count = struct.unpack_from(
+            "<III", data, pos + 1
+        )
+        cores.append({
+            "core": core,
+            "idle_pct": idle_pct,
+            "load_pct": 100 - idle_pct,
+            "context_switches": switches,
+            "irq_time_us": irq_time_us,
+            "irq_count": irq_count,
+        })
+        pos += CORE_LOAD_ENTRY_SIZE
+    return {
+        "window_us": window_us,
+        "flash_ops": flash_ops,
+        "flash_busy_us": flash_busy_us,
+        "cores": cores,
+    }
+
+
 def extract_packets(buffer: bytes) -> tuple[list[bytes], bytes]:
     """Extract complete vitals packets from a byte buffer.
 
@@ -300,18 +598,52 @@ def extract_packets(buffer: bytes) -> tuple[list[bytes], bytes]:
     packets = []
     offset = 0
 
-    while offset + HEADER_SIZE <= len(buffer):
-        # Peek at header to get task_count
-        pkt_type, _, _, _, task_count = struct.unpack_from(
-            HEADER_FORMAT, buffer, offset
-        )
+    while offset < len(buffer):
+        pkt_type = buffer[offset]
+
+        if pkt_type == PKT_BATCH:
+            if offset + BATCH_FRAME_HEADER > len(buffer):
+                break
+            (payload_len,) = struct.unpack_from("<H", buffer, offset + 2)
+            packet_size = BATCH_FRAME_HEADER + payload_len
+            if offset + packet_size > len(buffer):
+                break
+            packets.append(buffer[offset : offset + packet_size])
+            offset += packet_size
+            continue
 
-        if pkt_type != PKT_SYSTEM_VITALS:
+        if pkt_type == PKT_CORE_LOAD:
+            if offset + CORE_LOAD_HEADER_SIZE > len(buffer):
+                break
+            packet_size = (CORE_LOAD_HEADER_SIZE
+                           + buffer[offset + 13] * CORE_LOAD_ENTRY_SIZE)
+            if offset + packet_size > len(buffer):
+                break
+            packets.append(buffer[offset : offset + packet_size])
+            offset += packet_size
+            continue
+
+        if offset + HEADER_SIZE > len(buffer):
+            break
+        # Peek at header to get task_count
+        fields = struct.unpack_from(HEADER_FORMAT, buffer, offset)
+        task_count = fields[-1]
+
+        if pkt_type == PKT_SYSTEM_VITALS:
+            packet_size = HEADER_SIZE + task_count * TASK_ENTRY_SIZE
+        elif pkt_type == PKT_TASK_STATS:
+            packet_size = delta_packet_size(buffer, offset)
+            if packet_size is None:
+                break  # Incomplete delta packet — wait for more data
+        elif pkt_type == PKT_TRACE_STATS:
+            packet_size = 3 + buffer[offset + 2] * TRACE_ENTRY_SIZE
+        elif pkt_type == PKT_BOOT_TIMELINE:
+            packet_size = 3 + buffer[offset + 1] * BOOT_ENTRY_SIZE
+        else:
             # Unknown packet type — skip one byte and try again
             offset += 1
             continue
 
-        packet_size = HEADER_SIZE + task_count * TASK_ENTRY_SIZE
         if offset + packet_size > len(buffer):
             break  # Incomplete packet — wait for more data
 
@@ -355,6 +687,8 @@ def main():
     sock = connect_rtt(args.host, args.port)
     buffer = b""
     total_packets = 0
+    task_cache: dict = {}  # task_number → raw fields, for delta merging
+    batch_decoder = BatchDecoder()  # PKT_BATCH decompression state
 
     try:
         while True:
@@ -363,10 +697,69 @@ def main():
                 continue
 
             buffer += data
-            packets, buffer = extract_packets(buffer)
+            frames, buffer = extract_packets(buffer)
+
+            # Expand batch frames into their constituent packets
+            packets = []
+            for frame in frames:
+                if frame[0] == PKT_BATCH:
+                    packets.extend(batch_decoder.decode(frame))
+                else:
+                    packets.append(frame)
 
             for pkt_data in packets:
-                vitals = decode_vitals_packet(pkt_data)
+                if pkt_data[0] == PKT_BOOT_TIMELINE:
+                    timeline = decode_boot_timeline(pkt_data)
+                    print("[telemetry_manager] Boot timeline:", file=sys.stderr)
+                    for entry in timeline:
+                        print(
+                            f"    {entry['phase']:<8} "
+                            f"+{entry['duration_us']:>8} us "
+                            f"(t={entry['end_us']} us)",
+                            file=sys.stderr,
+                        )
+                    print(json.dumps({"event": "boot_timeline",
+                                      "phases": timeline}))
+                    sys.stdout.flush()
+                    continue
+                if pkt_data[0] == PKT_TRACE_STATS:
+                    continue  # Framed but not analyzed here yet
+                if pkt_data[0] == PKT_CORE_LOAD:
+                    load = decode_core_load_packet(pkt_data)
+                    if args.verbose:
+                        per_core = ", ".join(
+                            f"core{c['core']}={c['load_pct']}%"
+                            for c in load["cores"]
+                        )
+                        print(
+                            f"[core_load] {per_core}, "
+                            f"flash={load['flash_ops']} ops/"
+                            f"{load['flash_busy_us']} us",
+                            file=sys.stderr,
+                        )
+                    print(json.dumps({"event": "core_load", **load}))
+                    sys.stdout.flush()
+                    continue
+                if pkt_data[0] == PKT_TASK_STATS:
+                    vitals = decode_delta_packet(pkt_data, task_cache)
+                else:
+                    vitals = decode_vitals_packet(pkt_data)
+                    if vitals is not None:
+                        # Full snapshot resets the delta merge state
+                        task_cache.clear()
+                        for t in vitals["tasks"]:
+                            task_cache[t["task_number"]] = {
+                                "state": [k for k, v in TASK_STATES.items()
+                                          if v == t["state"]][0]
+                                if t["state"] in TASK_STATES.values() else 0,
+                                "priority": t["priority"],
+                                "stack_hwm": t["stack_hwm_words"],
+                                "cpu_pct": t["cpu_pct"],
+                                "runtime": t["runtime_ms"],
+                                "lat_max": t["lat_max_us"],
+                                "lat_mean": t["lat_mean_us"],
+                                "preempts": t["preemptions"],
+                            }
                 if vitals is None:
                     continue
 
@@ -377,7 +770,8 @@ def main():
                     print(
                         f"[{total_packets}] heap={vitals['free_heap']}, "
                         f"min={vitals['min_free_heap']}, "
-                        f"tasks={vitals['task_count']}",
+                        f"tasks={vitals['task_count']}, "
+                        f"drops={vitals['log_dropped']}+{vitals['telem_dropped']}",
                         file=sys.stderr,
                     )
 